@@ -0,0 +1,121 @@
+/**
+ * Screen Benchmark
+ *
+ * Renders the FancyTerminalExample components headless for N frames, with a
+ * scripted key press every 30 frames, and reports frames per second, bytes
+ * per frame and the time each component and the screen diff take per frame.
+ *
+ * Usage: ScreenBench [frames] [memory|null]
+ *
+ * `memory` keeps the frames in the screen buffer, `null` also writes them to
+ * /dev/null. Run it with the same arguments before and after a change to
+ * compare.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_screen.h>
+#include "../examples/FancyTerminal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_FRAMES 100000
+#define BENCH_ROWS   24
+#define BENCH_COLS   80
+#define BENCH_KEYS   "1231322"
+
+eer_screen_t screen;
+
+enum bench_part { CLOCK, ANIMATION, MENU, STATUS, RENDER, BENCH_PARTS };
+
+static const char *bench_names[BENCH_PARTS] = {"ClockComponent",
+                                               "AnimationComponent",
+                                               "MenuComponent",
+                                               "StatusComponent",
+                                               "eer_screen_render"};
+static double bench_time[BENCH_PARTS];
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+#define bench_measure(part, ...)                                               \
+  {                                                                            \
+    double begin = now_ns();                                                   \
+    __VA_ARGS__;                                                               \
+    bench_time[part] += now_ns() - begin;                                      \
+  }
+
+int main(int argc, char **argv) {
+  unsigned long frames = argc > 1 ? strtoul(argv[1], NULL, 10) : BENCH_FRAMES;
+  const char *target = argc > 2 ? argv[2] : "memory";
+  eer_loop_t bench;
+
+  if (!frames
+      || OK != eer_screen_headless(&screen,
+                                   strcmp(target, "null") ? EER_SCREEN_MEMORY
+                                                          : EER_SCREEN_NULL,
+                                   BENCH_ROWS, BENCH_COLS)) {
+    fprintf(stderr, "Usage: %s [frames] [memory|null]\n", argv[0]);
+    return 1;
+  }
+
+  double begin = now_ns();
+
+  eer_loop_init(&bench, NULL);
+  loop_on(&bench) {
+    uint64_t frame = eer_loop_iteration(&bench);
+    char key = frame % 30 == 29
+                   ? BENCH_KEYS[(frame / 30) % (sizeof(BENCH_KEYS) - 1)]
+                   : 0;
+    int speed = animationComponent.state.speed;
+    bool animation = animationComponent.state.enabled;
+    bool seconds = clockComponent.state.show_seconds;
+
+    // The example's key handling, folded into the props
+    if ('1' == key)
+      animation = !animation;
+    if ('2' == key)
+      seconds = !seconds;
+    if ('3' == key)
+      speed = speed % 3 + 1;
+    if (!frame) {
+      speed = 1;
+      animation = seconds = true;
+    }
+
+    bench_measure(CLOCK, react(ClockComponent, clockComponent,
+                               _({.show_seconds = seconds})));
+    bench_measure(ANIMATION,
+                  react(AnimationComponent, animationComponent,
+                        _({.speed = speed, .enabled = animation})));
+    bench_measure(MENU, react(MenuComponent, menuComponent, _({.key = key})));
+    bench_measure(STATUS, react(StatusComponent, statusComponent,
+                                _({.animation_speed = speed,
+                                   .animation_enabled = animation,
+                                   .show_seconds = seconds})));
+    bench_measure(RENDER, eer_screen_render(&screen));
+
+    exit_when(frame + 1 == frames);
+  }
+
+  double total = now_ns() - begin;
+
+  printf("%lu frames %dx%d to %s in %.1f ms\n\n", frames, BENCH_COLS,
+         BENCH_ROWS, target, total / 1e6);
+  printf("frames/s\t%.0f\n", frames / (total / 1e9));
+  printf("bytes/frame\t%.1f\n", (double)screen.bytes / frames);
+  printf("frames written\t%llu\n\n", (unsigned long long)screen.frames);
+  printf("part\t\t\tns/frame\n");
+  for (int part = 0; part < BENCH_PARTS; part++)
+    printf("%-20s\t%.0f\n", bench_names[part], bench_time[part] / frames);
+
+  eer_screen_release(&screen);
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * Stage Scan Benchmark
+ *
+ * Compares staging 1M components one by one with eer_staging() against the
+ * registry scan of the dense stage bytes, for 0.1%, 1% and 10% of the
+ * components having pending work in each pass.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_registry.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_COMPONENTS (1 << 20)
+#define BENCH_PASSES     20
+
+typedef struct {
+  int value;
+} BenchComponent_props_t;
+
+typedef struct {
+  int value;
+} BenchComponent_state_t;
+
+eer_header(BenchComponent);
+
+WILL_MOUNT_SKIP(BenchComponent);
+SHOULD_UPDATE_SKIP(BenchComponent);
+WILL_UPDATE_SKIP(BenchComponent);
+RELEASE(BenchComponent) { state->value = props->value; }
+DID_MOUNT_SKIP(BenchComponent);
+DID_UPDATE_SKIP(BenchComponent);
+DID_UNMOUNT_SKIP(BenchComponent);
+
+static BenchComponent_t components[BENCH_COMPONENTS];
+eer_registry(registry, BENCH_COMPONENTS);
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Mark every `stride`-th component as reacting, as if a producer touched it */
+static void bench_touch(size_t stride, size_t offset) {
+  for (size_t index = offset % stride; index < BENCH_COMPONENTS;
+       index += stride) {
+    components[index].instance.stage.state.step = EER_STAGE_REACTING;
+    eer_registry_sync(&registry, index);
+  }
+}
+
+static double bench_linear(size_t stride) {
+  double total = 0;
+
+  for (int pass = 0; pass < BENCH_PASSES; pass++) {
+    bench_touch(stride, pass);
+    double begin = now_ns();
+    for (size_t index = 0; index < BENCH_COMPONENTS; index++)
+      eer_staging(&components[index].instance, (void *)EER_CONTEXT_SAME);
+    total += now_ns() - begin;
+    for (size_t index = 0; index < BENCH_COMPONENTS; index++)
+      eer_registry_sync(&registry, index);
+  }
+
+  return total / BENCH_PASSES;
+}
+
+static double bench_registry(size_t stride) {
+  double total = 0;
+
+  for (int pass = 0; pass < BENCH_PASSES; pass++) {
+    bench_touch(stride, pass);
+    double begin = now_ns();
+    eer_registry_staging(&registry);
+    total += now_ns() - begin;
+  }
+
+  return total / BENCH_PASSES;
+}
+
+int main(void) {
+  static const struct {
+    const char *name;
+    enum eer_registry_scan scan;
+  } scans[] = {{"scalar", EER_REGISTRY_SCAN_SCALAR},
+               {"sse2", EER_REGISTRY_SCAN_SSE2},
+               {"avx2", EER_REGISTRY_SCAN_AVX2}};
+  static const struct {
+    const char *name;
+    size_t stride;
+  } activities[] = {{"0.1%", 1000}, {"1%", 100}, {"10%", 10}};
+
+  for (size_t index = 0; index < BENCH_COMPONENTS; index++) {
+    components[index] = (BenchComponent_t){
+        .instance = eer_define_component(BenchComponent, bench)};
+    eer_registry_add(&registry, &components[index].instance, NULL);
+  }
+
+  // Mount everything once so all components start RELEASED
+  eer_registry_staging(&registry);
+
+  printf("%d components, %d passes, time per pass in microseconds\n\n",
+         BENCH_COMPONENTS, BENCH_PASSES);
+  printf("activity\teer_staging");
+  for (size_t scan = 0; scan < sizeof(scans) / sizeof(*scans); scan++)
+    printf("\t%s", scans[scan].name);
+  printf("\n");
+
+  for (size_t activity = 0; activity < sizeof(activities) / sizeof(*activities);
+       activity++) {
+    printf("%s\t\t%.1f", activities[activity].name,
+           bench_linear(activities[activity].stride) / 1e3);
+    for (size_t scan = 0; scan < sizeof(scans) / sizeof(*scans); scan++) {
+      if (OK != eer_registry_select(scans[scan].scan)) {
+        printf("\t-");
+        continue;
+      }
+      printf("\t%.1f", bench_registry(activities[activity].stride) / 1e3);
+    }
+    printf("\n");
+  }
+
+  return 0;
+}
@@ -8,7 +8,6 @@
 #include <eer_app.h>
 #include <eer_comp.h>
 #include <stdio.h>
-#include <unistd.h>
 
 #include "components/my_component.h"
 
@@ -18,16 +17,16 @@ int main() {
     // Create component instances
     eer_withprops(MyComponent, myComponent, _({.value = 1}));
 
-    // Start the event loop
-    loop(myComponent) {
+    // Start the event loop, two iterations per second
+    eer_loop_t main_loop;
+
+    eer_loop_init(&main_loop, NULL);
+    eer_loop_at(&main_loop, 2, myComponent) {
         // Update the component value
         apply(MyComponent, myComponent,
               _({.value = myComponent.state.value + 1}));
 
         // Add your application logic here
-        
-        // Sleep to slow down the loop (remove in production)
-        usleep(500000);  // 500ms
 
         // Exit condition
         if (myComponent.state.update_count >= 5) {
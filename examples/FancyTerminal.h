@@ -0,0 +1,298 @@
+/**
+ * Fancy Terminal Components
+ *
+ * The component set of FancyTerminalExample, shared with ScreenBench so the
+ * benchmark renders exactly what the example shows. Components draw into
+ * `screen`, defined by the including program.
+ */
+
+#pragma once
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_screen.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+extern eer_screen_t screen;
+
+// Clock Component
+typedef struct {
+  bool show_seconds;
+} ClockComponent_props_t;
+
+typedef struct {
+  bool show_seconds;
+  char time_str[20];
+  int updates;
+} ClockComponent_state_t;
+
+eer_header(ClockComponent);
+
+WILL_MOUNT(ClockComponent) {
+  state->show_seconds = props->show_seconds;
+  state->updates = 0;
+  strcpy(state->time_str, "00:00:00");
+}
+
+SHOULD_UPDATE_SKIP(ClockComponent);
+WILL_UPDATE_SKIP(ClockComponent);
+
+RELEASE(ClockComponent) {
+  state->show_seconds = props->show_seconds;
+  
+  // Get current time
+  time_t now = time(NULL);
+  struct tm *tm_info = localtime(&now);
+  
+  if (state->show_seconds) {
+    strftime(state->time_str, sizeof(state->time_str), "%H:%M:%S", tm_info);
+  } else {
+    strftime(state->time_str, sizeof(state->time_str), "%H:%M", tm_info);
+  }
+  
+  state->updates++;
+}
+
+DID_UPDATE(ClockComponent) {
+  int col = screen.cols - 11;
+
+  eer_screen_color(&screen, EER_SCREEN_DEFAULT, EER_SCREEN_DEFAULT);
+  eer_screen_fill(&screen, 0, col, 10, ' ');
+  eer_screen_color(&screen, EER_SCREEN_CYAN, EER_SCREEN_BLACK);
+  eer_screen_print(&screen, 0, col + 10 - strlen(state->time_str), "%s",
+                   state->time_str);
+}
+
+DID_MOUNT(ClockComponent) {
+  // Initial render
+  eer_screen_color(&screen, EER_SCREEN_CYAN, EER_SCREEN_BLACK);
+  eer_screen_print(&screen, 0, screen.cols - 11, "%s", state->time_str);
+}
+
+DID_UNMOUNT_SKIP(ClockComponent);
+
+// Animation Component
+typedef struct {
+  int speed;
+  bool enabled;
+} AnimationComponent_props_t;
+
+typedef struct {
+  int speed;
+  bool enabled;
+  int frame;
+  int max_frames;
+  char frames[5][80];
+} AnimationComponent_state_t;
+
+eer_header(AnimationComponent);
+
+WILL_MOUNT(AnimationComponent) {
+  state->speed = props->speed;
+  state->enabled = props->enabled;
+  state->frame = 0;
+  state->max_frames = 5;
+  
+  // Define animation frames
+  strcpy(state->frames[0], "    *     *     *     *     *     *     *    ");
+  strcpy(state->frames[1], "   ***   ***   ***   ***   ***   ***   ***   ");
+  strcpy(state->frames[2], "  ***** ***** ***** ***** ***** ***** *****  ");
+  strcpy(state->frames[3], " *************************************** ");
+  strcpy(state->frames[4], "***************************************** ");
+}
+
+SHOULD_UPDATE(AnimationComponent) {
+  return props->enabled != next_props->enabled || 
+         props->speed != next_props->speed ||
+         state->enabled;
+}
+
+WILL_UPDATE_SKIP(AnimationComponent);
+
+RELEASE(AnimationComponent) {
+  state->speed = props->speed;
+  state->enabled = props->enabled;
+  
+  if (state->enabled) {
+    // Update animation frame
+    state->frame = (state->frame + 1) % state->max_frames;
+  }
+}
+
+void draw_animation(AnimationComponent_state_t *state) {
+  int padding = (screen.cols - (int)strlen(state->frames[0])) / 2;
+
+  eer_screen_color(&screen, EER_SCREEN_YELLOW, EER_SCREEN_BLACK);
+  eer_screen_fill(&screen, 2, padding, strlen(state->frames[0]), ' ');
+  eer_screen_print(&screen, 2, padding, "%s", state->frames[state->frame]);
+}
+
+DID_UPDATE(AnimationComponent) {
+  if (state->enabled)
+    draw_animation(state);
+}
+
+DID_MOUNT(AnimationComponent) {
+  // Initial render
+  draw_animation(state);
+}
+
+DID_UNMOUNT_SKIP(AnimationComponent);
+
+// Menu Component
+typedef struct {
+  char key;
+} MenuComponent_props_t;
+
+typedef struct {
+  char key;
+  int selected_item;
+  char menu_items[4][20];
+  char status_message[100];
+} MenuComponent_state_t;
+
+eer_header(MenuComponent);
+
+WILL_MOUNT(MenuComponent) {
+  state->key = props->key;
+  state->selected_item = 0;
+  
+  // Define menu items
+  strcpy(state->menu_items[0], "1. Toggle Animation");
+  strcpy(state->menu_items[1], "2. Toggle Seconds");
+  strcpy(state->menu_items[2], "3. Change Speed");
+  strcpy(state->menu_items[3], "q. Quit");
+  
+  strcpy(state->status_message, "Welcome to Fancy Terminal Example!");
+}
+
+SHOULD_UPDATE(MenuComponent) {
+  return props->key != next_props->key && next_props->key != 0;
+}
+
+WILL_UPDATE_SKIP(MenuComponent);
+
+RELEASE(MenuComponent) {
+  state->key = props->key;
+  
+  // Process menu selection
+  switch (state->key) {
+    case '1':
+      strcpy(state->status_message, "Animation toggled");
+      break;
+    case '2':
+      strcpy(state->status_message, "Seconds display toggled");
+      break;
+    case '3':
+      strcpy(state->status_message, "Animation speed changed");
+      break;
+    case 'q':
+      strcpy(state->status_message, "Exiting application...");
+      break;
+    default:
+      snprintf(state->status_message, sizeof(state->status_message), 
+               "Unknown command: %c", state->key);
+      break;
+  }
+}
+
+void draw_menu(MenuComponent_state_t *state) {
+  int menu_start_row = screen.rows - 9;
+
+  // Draw menu border
+  eer_screen_color(&screen, EER_SCREEN_WHITE, EER_SCREEN_BLUE);
+  eer_screen_fill(&screen, menu_start_row - 1, 1, 40, ' ');
+
+  // Draw menu items
+  for (int i = 0; i < 4; i++) {
+    if (i == state->selected_item) {
+      eer_screen_color(&screen, EER_SCREEN_BLACK, EER_SCREEN_WHITE);
+    } else {
+      eer_screen_color(&screen, EER_SCREEN_WHITE, EER_SCREEN_BLACK);
+    }
+    eer_screen_print(&screen, menu_start_row + i, 3, "%s",
+                     state->menu_items[i]);
+  }
+
+  // Draw status message
+  eer_screen_color(&screen, EER_SCREEN_DEFAULT, EER_SCREEN_DEFAULT);
+  eer_screen_fill(&screen, menu_start_row + 5, 3, screen.cols - 3, ' ');
+  eer_screen_color(&screen, EER_SCREEN_GREEN, EER_SCREEN_BLACK);
+  eer_screen_print(&screen, menu_start_row + 5, 3, "Status: %s",
+                   state->status_message);
+}
+
+DID_UPDATE(MenuComponent) { draw_menu(state); }
+
+DID_MOUNT(MenuComponent) {
+  // Initial render
+  draw_menu(state);
+}
+
+DID_UNMOUNT_SKIP(MenuComponent);
+
+// Status Component
+typedef struct {
+  int animation_speed;
+  bool animation_enabled;
+  bool show_seconds;
+} StatusComponent_props_t;
+
+typedef struct {
+  int animation_speed;
+  bool animation_enabled;
+  bool show_seconds;
+  int update_count;
+} StatusComponent_state_t;
+
+eer_header(StatusComponent);
+
+WILL_MOUNT(StatusComponent) {
+  state->animation_speed = props->animation_speed;
+  state->animation_enabled = props->animation_enabled;
+  state->show_seconds = props->show_seconds;
+  state->update_count = 0;
+}
+
+SHOULD_UPDATE(StatusComponent) {
+  return props->animation_speed != next_props->animation_speed ||
+         props->animation_enabled != next_props->animation_enabled ||
+         props->show_seconds != next_props->show_seconds;
+}
+
+WILL_UPDATE_SKIP(StatusComponent);
+
+RELEASE(StatusComponent) {
+  state->animation_speed = props->animation_speed;
+  state->animation_enabled = props->animation_enabled;
+  state->show_seconds = props->show_seconds;
+  state->update_count++;
+}
+
+void draw_status(StatusComponent_state_t *state) {
+  eer_screen_color(&screen, EER_SCREEN_MAGENTA, EER_SCREEN_BLACK);
+  eer_screen_print(&screen, screen.rows - 3, 1,
+                   "Animation: %s | Speed: %d | Seconds: %s | Updates: %d",
+                   state->animation_enabled ? "ON " : "OFF",
+                   state->animation_speed,
+                   state->show_seconds ? "ON " : "OFF",
+                   state->update_count);
+}
+
+DID_UPDATE(StatusComponent) { draw_status(state); }
+
+DID_MOUNT(StatusComponent) { draw_status(state); }
+
+DID_UNMOUNT_SKIP(StatusComponent);
+
+// Create component instances
+eer_withprops(ClockComponent, clockComponent, _({.show_seconds = true}));
+eer_withprops(AnimationComponent, animationComponent, _({.speed = 1, .enabled = true}));
+eer_withprops(MenuComponent, menuComponent, _({.key = 0}));
+eer_withprops(StatusComponent, statusComponent, 
+              _({.animation_speed = 1, 
+                 .animation_enabled = true, 
+                 .show_seconds = true}));
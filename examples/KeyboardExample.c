@@ -5,11 +5,15 @@
  * It uses two components:
  * - KeyboardComponent: Captures keyboard input
  * - CommandComponent: Processes commands based on keyboard input
+ *
+ * Standard input is read by an FdInput: the loop blocks until a key
+ * arrives instead of polling read() every iteration.
  */
 
 #include <eer.h>
 #include <eer_app.h>
 #include <eer_comp.h>
+#include <eer_fd.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -28,14 +32,22 @@ void enable_raw_mode() {
 
 void disable_raw_mode() { tcsetattr(STDIN_FILENO, TCSAFLUSH, &orig_termios); }
 
+eer_loop_t main_loop;
+eer_idle_t idle = EER_IDLE(.timeout_us = 0);
+
+// Bytes of standard input, filled only when epoll reports them
+eer_fd(keys, STDIN_FILENO, &main_loop, 64);
+
 // Define the Keyboard component
 typedef struct {
   bool enabled;
+  eer_ring_t *input;
 } KeyboardComponent_props_t;
 
 typedef struct {
   bool enabled;
-  char key;
+  char keys[64];
+  size_t count;
 } KeyboardComponent_state_t;
 
 eer_header(KeyboardComponent);
@@ -43,33 +55,23 @@ eer_header(KeyboardComponent);
 // Lifecycle methods for KeyboardComponent
 WILL_MOUNT(KeyboardComponent) {
   state->enabled = props->enabled;
-  state->key = 0;
+  state->count = 0;
   printf("Keyboard component initialized\n");
 }
 
-SHOULD_UPDATE(KeyboardComponent) {
-  // Read keyboard input if enabled
-  if (state->enabled) {
-    char c = 0;
-    if (read(STDIN_FILENO, &c, 1) == 1) {
-      state->key = c;
-      return true;
-    } else {
-     return false;
-    }
-  }    
-}
-
+SHOULD_UPDATE_SKIP(KeyboardComponent);
 WILL_UPDATE_SKIP(KeyboardComponent);
 
 RELEASE(KeyboardComponent) {
-	printf("Keyboard release\n");
-
-
+  // Take every key that arrived since the last update
+  state->count = state->enabled ? eer_ring_pop_batch(props->input, state->keys,
+                                                     sizeof(state->keys))
+                                : 0;
 }
 
 DID_UPDATE(KeyboardComponent) {
-    printf("Key pressed: %c\n", state->key);
+  for (size_t index = 0; index < state->count; index++)
+    printf("Key pressed: %c\n", state->keys[index]);
 }
 
 DID_MOUNT(KeyboardComponent) {
@@ -83,7 +85,8 @@ DID_UNMOUNT(KeyboardComponent) {
 }
 
 // Create a keyboard component instance
-eer_withprops(KeyboardComponent, keyboard, _({.enabled = true}));
+eer_withprops(KeyboardComponent, keyboard,
+              _({.enabled = true, .input = &keys_bytes}));
 
 // Define the Command component
 typedef struct {
@@ -160,23 +163,36 @@ int main() {
   printf("Starting Keyboard Example\n");
   printf("Press keys to issue commands (q to quit)\n");
 
-  // Start the event loop
-  loop() {
+  eer_idle_init(&idle);
+  eer_loop_init(&main_loop, NULL);
+  eer_loop_idle(&main_loop, &idle);
+
+  // Start the event loop, it sleeps until standard input is readable
+  loop_on(&main_loop) {
+    eer_fd_receive(keys);
+
     // Use the keyboard component to get input
-    with(keyboard) {
+    receive(KeyboardComponent, keyboard, keys_bytes);
+
+    for (size_t index = 0; index < keyboard.state.count; index++) {
+      char key = keyboard.state.keys[index];
+
       // Process the keyboard input with the command component
-      apply(CommandComponent, command, _({.key = keyboard.state.key}));
+      react(CommandComponent, command, _({.key = key}));
 
       // Exit if 'q' is pressed
-      if (keyboard.state.key == 'q') {
+      if (key == 'q') {
         printf("Exiting application\n");
         eer_land.state.unmounted = true;
+        break;
       }
     }
+    keyboard.state.count = 0;
 
-    // Small delay to prevent CPU hogging
-    usleep(10000); // 10ms delay
+    // Stop when standard input is closed
+    exit_when(keys.state.closed);
   }
+  eer_idle_release(&idle);
 
   printf("Keyboard Example Completed\n");
   return 0;
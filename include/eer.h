@@ -4,6 +4,7 @@
 #include "interface.h"
 #include "magic.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -111,13 +112,75 @@
 #define eer_react(Type, name, propsValue)                                      \
   {                                                                            \
     Type##_props_t next_props = propsValue;                                    \
-    eer_staging(&name.instance, (void *)eer_land.state.context);               \
+    eer_staging(&name.instance, (void *)(uintptr_t)eer_land.state.context);    \
     if (EER_CONTEXT_BLOCKED != eer_land.state.context) {                       \
       name.instance.stage.state.step = EER_STAGE_REACTING;                     \
       eer_staging(&name.instance, &next_props);                                \
     }                                                                          \
   }
 
+/**
+ * @brief Stage a component without new props, so it is only mounted or
+ *        unmounted when needed
+ * @param name The component instance
+ */
+#define eer_keep(name)                                                         \
+  eer_staging(&name.instance,                                                  \
+              (void *)(uintptr_t)(EER_CONTEXT_BLOCKED == eer_land.state.context \
+                                      ? EER_CONTEXT_BLOCKED                    \
+                                      : EER_CONTEXT_SAME))
+
+/**
+ * @brief Update a mounted component with its current props when `ready`,
+ *        like react(), otherwise only mount or unmount it when needed
+ *
+ * Event sources such as channels, descriptors and I/O requests use it to
+ * run the hooks of their component only when there is something to read.
+ *
+ * @param name The component instance
+ * @param ready Condition for the update, evaluated once per call
+ */
+#define eer_react_when(name, ready)                                            \
+  if (EER_STAGE_RELEASED == name.instance.stage.state.step &&                  \
+      EER_CONTEXT_BLOCKED != eer_land.state.context && (ready)) {              \
+    name.instance.stage.state.step = EER_STAGE_REACTING;                       \
+    eer_staging(&name.instance, &name.props);                                  \
+  } else {                                                                     \
+    eer_keep(name);                                                            \
+  }
+
+/**
+ * @brief Apply props to many components as one transaction
+ *
+ * Works like calling apply() on every entry, but each lifecycle hook runs
+ * over the whole batch before the next one: release and did_update of the
+ * entries prepared in the previous iteration, then should_update over the
+ * batch and will_update over the survivors. Every accepted entry is
+ * PREPARED in the same iteration and released together in the next one, so
+ * pass the same batch on every iteration, like apply().
+ *
+ * Example:
+ * ```c
+ * struct eer_batch channels[] = {
+ *   eer_batch_item(Channel, left, _({.level = left_level})),
+ *   eer_batch_item(Channel, right, _({.level = right_level})),
+ * };
+ * apply_batch(channels, 2);
+ * ```
+ *
+ * @param batch Array of struct eer_batch
+ * @param count Number of entries
+ */
+#define eer_apply_batch(batch, count)                                          \
+  eer_staging_batch(batch, count, eer_land.state.context)
+
+/**
+ * @brief Batch entry for eer_apply_batch, props live until the end of the
+ *        enclosing block
+ */
+#define eer_batch_item(Type, name, propsValue)                                 \
+  {.instance = &name.instance, .next_props = &(Type##_props_t)propsValue}
+
 #define eer_shut(x)                                                            \
   x.instance.stage.state.step = EER_STAGE_UNMOUNTED;                           \
   eer_staging(&x.instance, 0);
@@ -209,8 +272,40 @@ union eer_stage {
   uint8_t flags;
 };
 
+/**
+ * @brief Lifecycle hooks run by a stage transition, in execution order
+ */
+enum eer_action {
+  EER_ACTION_SHOULD_UPDATE = 1 << 0, /* Gate, the transition stops on false */
+  EER_ACTION_WILL_MOUNT = 1 << 1,
+  EER_ACTION_WILL_UPDATE = 1 << 2,
+  EER_ACTION_RELEASE = 1 << 3,
+  EER_ACTION_DID_MOUNT = 1 << 4,
+  EER_ACTION_DID_UPDATE = 1 << 5,
+  EER_ACTION_DID_UNMOUNT = 1 << 6
+};
+
+/**
+ * @brief Entry of the (stage, context) transition table used by eer_staging
+ */
+struct eer_transition {
+  uint8_t actions; /* enum eer_action mask, 0 leaves the component as is */
+  uint8_t next;    /* Stage after the transition */
+  uint8_t context; /* Context returned by eer_staging */
+};
+
+#define EER_STAGES 8 /* Every value of the 3-bit step field */
+/* Columns: EER_CONTEXT_SAME, EER_CONTEXT_UPDATED, EER_CONTEXT_BLOCKED and
+ * EER_TRANSITION_PROPS for a pointer to next props */
+#define EER_TRANSITION_PROPS 3
+#define EER_TRANSITION_CONTEXTS 4
+
+extern const struct eer_transition eer_transitions[EER_STAGES]
+                                                  [EER_TRANSITION_CONTEXTS];
+
 typedef struct eer {
   union eer_stage stage;
+  uint32_t version; /* Bumped by every release, see eer_changed() */
 
   void (*will_mount)(void *instance, void *next_props);
 
@@ -223,9 +318,85 @@ typedef struct eer {
   void (*did_update)(void *instance);
   void (*did_unmount)(void *instance);
 
+  /* will_update, release and did_update fused into one call, set by the
+   * first release of components defined with UPDATE(Type) */
+  void (*update)(void *instance, void *next_props);
+
+  /* Stage byte in a registry, refreshed by eer_staging(), see eer_registry.h */
+  uint8_t *mirror;
+
 #ifdef PROFILING
   PROFILING_STRUCT
 #endif
 } eer_t;
 
+/**
+ * @brief Version of a component's state, bumped by every release
+ * @param name The component instance
+ */
+#define eer_version(name) ((name).instance.version)
+
+/**
+ * @brief Check whether a component was released since `seen` was saved
+ *
+ * Consumers keep the last version they looked at and skip unchanged
+ * components with one integer compare:
+ *
+ * ```c
+ * static uint32_t seen;
+ *
+ * if (eer_changed(sensor, seen))
+ *   redraw(sensor.state.value);
+ * ```
+ *
+ * @param name The component instance
+ * @param seen uint32_t holding the version seen last, updated
+ */
+#define eer_changed(name, seen) eer_changed_since(&(name).instance, &(seen))
+
+static inline bool eer_changed_since(const eer_t *instance, uint32_t *seen) {
+  if (instance->version == *seen)
+    return false;
+
+  *seen = instance->version;
+  return true;
+}
+
+struct eer_batch {
+  eer_t *instance;
+  void *next_props; /* Props of the instance type, copied by will_update */
+  uint8_t step;     /* Scratch space of eer_staging_batch */
+};
+
 enum eer_context eer_staging(eer_t *instance, void *next_props);
+enum eer_context eer_staging_batch(struct eer_batch *batch, size_t count,
+                                   enum eer_context context);
+
+/**
+ * @brief Whether eer_staging left a component PREPARED on the calling thread
+ *        since the last call. Loops use it to run the next stage at once.
+ */
+bool eer_staging_pending(void);
+
+/**
+ * @brief Mark a component whose props and state were restored from storage
+ *        as RELEASED without running its hooks, and refresh its registry
+ *        mirror. Version counters are left to the caller.
+ */
+void eer_staging_restore(eer_t *instance);
+
+/**
+ * @brief React with `next_props` when they differ from the `size` bytes at
+ *        `props` and should_update agrees, as collections do for children.
+ *        Padding bytes take part in the comparison, props types compared
+ *        this way must have none.
+ * @return true when the component updated
+ */
+bool eer_staging_update(eer_t *instance, const void *props, void *next_props,
+                        size_t size);
+
+/**
+ * @brief Unmount a pooled child and reset it to `prototype`. The version
+ *        keeps counting for consumers of the old child.
+ */
+void eer_staging_unmount(eer_t *instance, const eer_t *prototype);
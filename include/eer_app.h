@@ -1,6 +1,7 @@
 #pragma once
 
 #include "eer_common.h"
+#include "eer_loop.h"
 
 /**
  * @file eer_app.h
@@ -13,6 +14,7 @@
 #define ignite eer_init
 #define loop   eer_loop
 #define app    eer_loop
+#define loop_on eer_loop_run
 
 /* Control flow macros */
 #define halt      eer_halt
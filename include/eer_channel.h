@@ -0,0 +1,103 @@
+#pragma once
+
+#include "eer.h"
+#include "eer_ring.h"
+
+/**
+ * @file eer_channel.h
+ * @brief Bounded lock-free channels between loops
+ *
+ * A channel is a single-producer single-consumer eer_ring_t of fixed-size
+ * items. One loop sends, another loop receives, and neither takes a lock.
+ * Capacity must be a power of two.
+ *
+ * receive() stages the receiving component only when its channel has data,
+ * so idle stages of a pipeline cost one load per iteration.
+ *
+ * Example:
+ * ```c
+ * eer_channel(sample_t, samples, 256);
+ *
+ * // Acquisition loop
+ * if (eer_channel_send(&samples, &sample) == ERROR_BUFFER_FULL)
+ *     dropped++;
+ *
+ * // Processing loop, Filter drains props->input in RELEASE
+ * loop_on(&core1) {
+ *     receive(Filter, filter, samples);
+ * }
+ * ```
+ *
+ * Channels move items as bytes of the size given to eer_channel(). For
+ * compile-time checked items, eer_channel_typed() defines send and receive
+ * functions for one item type:
+ *
+ * ```c
+ * eer_channel_typed(sample_t, sample);
+ *
+ * sample_send(&samples, &sample);                   // const sample_t *
+ * count = sample_receive_batch(&samples, items, 16); // sample_t *
+ * ```
+ */
+
+typedef eer_ring_t eer_channel_t;
+
+/**
+ * @brief Defines a channel with static storage for `capacity` items of Type
+ * @param Type Item type
+ * @param name The channel name
+ * @param capacity Number of items, a power of two
+ */
+#define eer_channel(Type, name, capacity) eer_ring(Type, name, capacity)
+
+/**
+ * @brief Run the update of a component when its channel has data
+ *
+ * With pending items the component updates at once like react() with its
+ * current props, and its hooks drain the channel. Otherwise it is only
+ * mounted or unmounted when needed.
+ *
+ * @param Type The component type
+ * @param name The component instance
+ * @param channel The channel the component reads from
+ */
+#define eer_receive(Type, name, channel)                                       \
+    eer_react_when(name, eer_channel_count(&channel))
+
+/* Producer side */
+#define eer_channel_send       eer_ring_push       /* OK or ERROR_BUFFER_FULL */
+#define eer_channel_send_batch eer_ring_push_batch /* Number of items sent */
+
+/* Consumer side */
+#define eer_channel_receive       eer_ring_pop       /* OK or ERROR_BUFFER_EMPTY */
+#define eer_channel_receive_batch eer_ring_pop_batch /* Number received */
+
+#define eer_channel_count eer_ring_count
+
+/**
+ * @brief Defines `prefix##_send`, `prefix##_send_batch`, `prefix##_receive`
+ *        and `prefix##_receive_batch` taking `Type` items, at file scope
+ * @param Type Item type of the channels passed to the functions
+ * @param prefix Prefix of the function names
+ */
+#define eer_channel_typed(Type, prefix)                                        \
+    static inline eer_result_t prefix##_send(eer_channel_t *channel,           \
+                                             const Type    *item)              \
+    {                                                                          \
+        return eer_ring_push(channel, item);                                   \
+    }                                                                          \
+    static inline size_t prefix##_send_batch(eer_channel_t *channel,           \
+                                             const Type *items, size_t count)  \
+    {                                                                          \
+        return eer_ring_push_batch(channel, items, count);                     \
+    }                                                                          \
+    static inline eer_result_t prefix##_receive(eer_channel_t *channel,        \
+                                                Type          *item)           \
+    {                                                                          \
+        return eer_ring_pop(channel, item);                                    \
+    }                                                                          \
+    static inline size_t prefix##_receive_batch(eer_channel_t *channel,        \
+                                                Type *items, size_t count)     \
+    {                                                                          \
+        return eer_ring_pop_batch(channel, items, count);                      \
+    }
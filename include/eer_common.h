@@ -1,6 +1,9 @@
 #pragma once
 
 #include "eer.h"
+#include "eer_channel.h"
+#include "eer_hal.h"
+#include "eer_rate.h"
 
 /* Common type definitions */
 #define result_t eer_result_t
@@ -11,7 +14,12 @@
 #define react    eer_react
 #define with     eer_with
 #define apply    eer_apply
+#define apply_batch eer_apply_batch
 #define use      eer_use
+#define receive  eer_receive
+#define react_when eer_react_when
+#define react_limited eer_react_limited
+#define flush_limited eer_flush_limited
 
 /* Common hardware abstractions */
 #define hw(system)        eer_hw_##system
@@ -43,7 +43,8 @@
     void Type##_release(void *instance);                                       \
     void Type##_did_mount(void *instance);                                     \
     void Type##_did_unmount(void *instance);                                   \
-    void Type##_did_update(void *instance)
+    void Type##_did_update(void *instance);                                    \
+    void Type##_update(void *instance, void *next_props)
 
 /**
  * @brief Defines the core component structure for a component of type `Type`.
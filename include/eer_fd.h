@@ -0,0 +1,75 @@
+#pragma once
+
+#include "eer.h"
+#include "eer_comp.h"
+#include "eer_loop.h"
+#include "eer_ring.h"
+
+/**
+ * @file eer_fd.h
+ * @brief Input component for non-blocking file descriptors
+ *
+ * Reading a descriptor in should_update costs a syscall per component and
+ * iteration, even when nothing arrived. An FdInput registers its descriptor
+ * with the epoll set of the loop idle object, see eer_idle.h. The loop marks
+ * it ready when bytes arrive, and only then one readv() moves everything
+ * that fits into a byte ring. Components consume the ring with receive().
+ *
+ * ```c
+ * eer_fd(keys, STDIN_FILENO, &main_loop, 256);
+ *
+ * eer_idle_init(&idle);
+ * eer_loop_idle(&main_loop, &idle);
+ * loop_on(&main_loop) {
+ *     eer_fd_receive(keys);
+ *     receive(Keyboard, keyboard, keys_bytes);
+ * }
+ * ```
+ *
+ * The descriptor is switched to O_NONBLOCK on mount. End of file or a read
+ * error removes it from the epoll set and sets state.closed.
+ *
+ * When the ring is full the input leaves the epoll set and sets
+ * state.paused, so unread bytes do not wake the loop over and over. A loop
+ * hook watches it again at the end of the first iteration that finds room in
+ * the ring. A consumer on another thread calls eer_loop_wake() after it
+ * drains a paused input, otherwise the loop may idle until its timeout.
+ */
+
+typedef struct {
+    int         fd;
+    eer_ring_t *buffer; /* Ring of uint8_t, filled in release */
+    eer_loop_t *loop;   /* Loop with an idle object */
+} FdInput_props_t;
+
+typedef struct {
+    struct eer_watch watch;
+    bool             watched;
+    bool             paused; /* Unwatched until the ring has room */
+    bool             hooked; /* Resume hook registered with the loop */
+    bool             closed;
+    int              error;    /* errno of the failed read, 0 on end of file */
+    uint64_t         reads;    /* readv() calls */
+    uint64_t         received; /* Bytes moved into the ring */
+} FdInput_state_t;
+
+eer_header(FdInput);
+
+/**
+ * @brief Defines an FdInput named `name` with a ring `name##_bytes`
+ * @param name The component instance
+ * @param descriptor The file descriptor to read
+ * @param owner Pointer to the loop, it needs an idle object
+ * @param capacity Ring size in bytes, a power of two
+ */
+#define eer_fd(name, descriptor, owner, capacity)                              \
+    eer_ring(uint8_t, name##_bytes, capacity);                                 \
+    eer_withprops(FdInput, name,                                               \
+                  _({.fd = descriptor, .buffer = &name##_bytes, .loop = owner}))
+
+/**
+ * @brief Read the descriptor of an FdInput when the loop found it readable,
+ *        otherwise only mount or unmount it when needed
+ * @param name The FdInput instance
+ */
+#define eer_fd_receive(name) eer_react_when(name, name.state.watch.ready)
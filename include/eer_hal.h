@@ -0,0 +1,104 @@
+#pragma once
+
+#include "interface.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file eer_hal.h
+ * @brief Hardware abstraction layer
+ *
+ * Components talk to peripherals through handler tables reached with
+ * hw(system), so the same component runs on a board or in the simulation:
+ *
+ * ```c
+ * pin_t led = hw_pin(PORTB, 5);
+ *
+ * hw(gpio).mode(&led, EER_PIN_OUTPUT);
+ * hw(gpio).toggle(&led);
+ * hw(uart).write((const uint8_t *)"ready\n", 6);
+ * ```
+ *
+ * hw(flash) is only needed by applications persisting state with
+ * eer_journal.h.
+ *
+ * The PLATFORM CMake cache entry selects the implementation. `simulation`
+ * builds src/hal/simulation.c, see eer_sim.h for its controls. Other
+ * platforms link their own definitions of the eer_hw_* tables and
+ * eer_now_us().
+ */
+
+typedef struct eer_pin {
+    uint8_t port;
+    uint8_t number;
+} eer_pin_t;
+
+#define eer_hw_pin(port, pin) ((eer_pin_t){port, pin})
+
+enum eer_pin_mode { EER_PIN_INPUT, EER_PIN_INPUT_PULLUP, EER_PIN_OUTPUT };
+
+typedef struct eer_gpio_handler {
+    void (*mode)(eer_pin_t *pin, enum eer_pin_mode mode);
+    bool (*get)(eer_pin_t *pin);
+    void (*set)(eer_pin_t *pin);
+    void (*clear)(eer_pin_t *pin);
+    void (*toggle)(eer_pin_t *pin);
+} eer_gpio_handler_t;
+
+typedef struct eer_uart_handler {
+    /** @return OK or ERROR_BUFFER_FULL when not every byte fits */
+    eer_result_t (*write)(const uint8_t *data, size_t size);
+    /** @return Number of bytes read */
+    size_t (*read)(uint8_t *data, size_t size);
+} eer_uart_handler_t;
+
+/** @brief Software timer, the callback runs with the timer as trigger */
+typedef struct eer_timer {
+    uint64_t          deadline; /* Microseconds of eer_now_us() */
+    uint64_t          period;   /* 0 for one-shot timers */
+    eer_callback_t    callback;
+    struct eer_timer *next;
+    bool              armed;
+} eer_timer_t;
+
+typedef struct eer_timer_handler {
+    /** @brief Monotonic time in microseconds */
+    uint64_t (*now)(void);
+    /** @brief Wait until `deadline`, firing the timers due on the way */
+    void (*sleep_until)(uint64_t deadline);
+    /** @brief Busy-wait until `deadline` without giving up the CPU */
+    void (*spin_until)(uint64_t deadline);
+    void (*start)(eer_timer_t *timer, uint64_t delay, uint64_t period,
+                  eer_callback_t callback);
+    void (*stop)(eer_timer_t *timer);
+    /** @brief Fire the timers due now, returns how many fired */
+    size_t (*poll)(void);
+    /** @brief Deadline of the next armed timer or UINT64_MAX */
+    uint64_t (*next_deadline)(void);
+} eer_timer_handler_t;
+
+/**
+ * @brief NOR flash split into equal sectors
+ *
+ * Erasing a sector sets its bytes to 0xFF, programming can only clear bits:
+ * a byte is programmed once between two erases of its sector.
+ */
+typedef struct eer_flash_handler {
+    /** @brief Size of an erase sector in bytes, 0 without flash */
+    uint32_t (*sector_size)(void);
+    uint16_t (*sectors)(void);
+    /** @return OK or ERROR_UNKNOWN outside the flash */
+    eer_result_t (*read)(uint32_t address, void *data, size_t size);
+    /** @return OK or ERROR_UNKNOWN when a bit would have to be set */
+    eer_result_t (*program)(uint32_t address, const void *data, size_t size);
+    eer_result_t (*erase)(uint16_t sector);
+} eer_flash_handler_t;
+
+extern eer_gpio_handler_t  eer_hw_gpio;
+extern eer_uart_handler_t  eer_hw_uart;
+extern eer_timer_handler_t eer_hw_timer;
+extern eer_flash_handler_t eer_hw_flash;
+
+/** @brief Monotonic time in microseconds, same as hw(timer).now() */
+uint64_t eer_now_us(void);
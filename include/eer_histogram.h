@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @file eer_histogram.h
+ * @brief Fixed-size histogram for latency and jitter measurements
+ *
+ * Values are counted in log-linear buckets: every power of two is split
+ * into 8 buckets, so percentiles are within 12.5% of the recorded values
+ * from nanoseconds to hours without allocation. Adding a value is a few
+ * instructions and safe in a loop iteration.
+ *
+ * ```c
+ * eer_histogram_t latency = {0};
+ *
+ * eer_histogram_add(&latency, done_ns - raised_ns);
+ * eer_histogram_report(&latency, "irq latency ns", stdout);
+ * ```
+ */
+
+#define EER_HISTOGRAM_SUBBUCKETS 8
+#define EER_HISTOGRAM_BUCKETS (62 * EER_HISTOGRAM_SUBBUCKETS)
+
+typedef struct eer_histogram {
+    uint32_t buckets[EER_HISTOGRAM_BUCKETS];
+    uint64_t count;
+    uint64_t min;
+    uint64_t max;
+    uint64_t sum;
+} eer_histogram_t;
+
+void eer_histogram_add(eer_histogram_t *histogram, uint64_t value);
+
+/**
+ * @brief Value below which `percentile` percent of the values fall
+ * @param histogram The histogram
+ * @param percentile 0 to 100
+ * @return Upper bound of the bucket holding the percentile, 0 when empty
+ */
+uint64_t eer_histogram_percentile(eer_histogram_t *histogram,
+                                  double           percentile);
+
+/**
+ * @brief Print count, min, mean, p50, p99, p99.9 and max on one line
+ */
+void eer_histogram_report(eer_histogram_t *histogram, const char *name,
+                          FILE *output);
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "interface.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @file eer_idle.h
+ * @brief Spin, yield and block idle strategy for event-driven loops
+ *
+ * A loop that waits for work from other threads either blocks and pays the
+ * wake-up latency on every event, or spins and burns a core. An idle object
+ * does both in phases: after the last event the loop busy-polls for
+ * `spin_us`, then calls sched_yield() for `yield_us`, then blocks on an
+ * eventfd until a producer calls eer_idle_notify() or `timeout_us` passes.
+ *
+ * With `adaptive` set the spin and yield windows follow the observed
+ * inter-arrival time of events: a loop fed every few microseconds keeps
+ * spinning, a loop fed a few times per second blocks almost at once.
+ * `spin_max_us` bounds the CPU time spent per idle period. On a single CPU
+ * the producer cannot run while the loop spins, so adaptive tuning only
+ * opens the yield window there.
+ *
+ * ```c
+ * eer_idle_t idle = EER_IDLE(.adaptive = true, .spin_max_us = 200);
+ *
+ * eer_idle_init(&idle);
+ * eer_loop_idle(&core1, &idle);
+ * loop_on(&core1) {
+ *     receive(Filter, filter, samples);
+ * }
+ *
+ * // Producer thread
+ * eer_channel_send(&samples, &sample);
+ * eer_loop_wake(&core1);
+ * ```
+ *
+ * File descriptors registered with eer_idle_watch() share the epoll set of
+ * the block phase. Their readiness is collected without waiting when an
+ * iteration had work, between yields and while blocking, so readers only
+ * touch a descriptor that has data. The spin phase only watches
+ * eer_idle_notify().
+ *
+ * The adaptive windows follow the events that end idle periods:
+ * eer_idle_notify() calls and readable descriptors. Those are what wakes a
+ * loop to react, and timing every eer_react() instead would put a clock read
+ * into each component update.
+ *
+ * Outside Linux there is no eventfd and descriptors cannot be watched. The
+ * yield phase only relaxes the core and the block phase sleeps through
+ * eer_hw_timer in naps of EER_IDLE_NAP_US until the next event or the
+ * timeout.
+ */
+
+/** @brief Phases of an idle period */
+enum eer_idle_phase { EER_IDLE_SPIN, EER_IDLE_YIELD, EER_IDLE_BLOCK };
+
+#define EER_IDLE_PHASES 3
+#define EER_IDLE_EVENTS 16 /* Descriptor events collected per epoll_wait */
+#define EER_IDLE_NAP_US 1000 /* Block phase sleep without an eventfd */
+
+/** @brief Descriptor watched for input, see eer_idle_watch() */
+struct eer_watch {
+    int  fd;
+    bool ready; /* Set by the loop when readable, cleared by the reader */
+};
+
+/** @brief Counters of one phase */
+struct eer_idle_counter {
+    uint64_t time_ns; /* Time spent waiting in the phase */
+    uint64_t wakes;   /* Idle periods that ended in the phase */
+};
+
+typedef struct eer_idle {
+    uint32_t spin_us;     /* Busy-poll window, tuned when adaptive */
+    uint32_t yield_us;    /* sched_yield() window after spinning */
+    uint32_t timeout_us;  /* Longest block, 0 blocks until notified */
+    bool     adaptive;    /* Tune the windows from inter-arrival times */
+    uint32_t spin_max_us; /* Upper bound of the adaptive spin window */
+
+    uint64_t interval_ns; /* Average time between events */
+    uint64_t last_ns;     /* Time of the last event seen by the loop */
+    uint64_t events;      /* Bumped by eer_idle_notify() */
+    uint64_t seen;        /* Events the loop has woken up for */
+    uint8_t  sleeping;
+    bool     uniprocessor; /* Spinning cannot overlap with producers */
+    int      fd; /* eventfd, -1 without one */
+    int      poll;
+    uint16_t watches;
+
+    struct eer_idle_counter counters[EER_IDLE_PHASES];
+} eer_idle_t;
+
+/**
+ * @brief Initializer of an idle object with the given windows and no
+ *        descriptor open, so wake-ups before eer_idle_init() write nowhere
+ */
+#define EER_IDLE(...) {.fd = -1, .poll = -1, __VA_ARGS__}
+
+/**
+ * @brief Open the wake-up descriptors, keeps the configured windows
+ * @return OK or ERROR_UNKNOWN when no descriptor could be opened
+ */
+eer_result_t eer_idle_init(eer_idle_t *idle);
+
+/**
+ * @brief Close the wake-up descriptors
+ */
+void eer_idle_release(eer_idle_t *idle);
+
+/**
+ * @brief Add a readable descriptor to the epoll set, level-triggered
+ * @param idle Idle object prepared with eer_idle_init()
+ * @param watch Descriptor and ready flag, must stay valid while watched
+ * @return OK or ERROR_UNKNOWN when it cannot be watched
+ */
+eer_result_t eer_idle_watch(eer_idle_t *idle, struct eer_watch *watch);
+
+/**
+ * @brief Remove a descriptor from the epoll set
+ */
+void eer_idle_unwatch(eer_idle_t *idle, struct eer_watch *watch);
+
+/**
+ * @brief Signal new work to the loop waiting on `idle`, safe to call from
+ *        any thread
+ */
+void eer_idle_notify(eer_idle_t *idle);
+
+/**
+ * @brief Wait until the next notification unless one arrived since the last
+ *        wait. Called by the loop after every iteration.
+ */
+void eer_idle_wait(eer_idle_t *idle);
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "eer.h"
+#include "eer_idle.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file eer_io.h
+ * @brief Batched asynchronous reads and writes for file and socket components
+ *
+ * Components that stream files or sockets pay a syscall for every read()
+ * and write() in their hooks. An I/O context queues requests instead:
+ * components submit them in release or did_update, the loop submits the
+ * whole batch and reaps the completions once per iteration, and
+ * eer_io_receive() updates the component whose request completed.
+ *
+ * ```c
+ * eer_io_t          io;
+ * eer_io_request_t  chunk = {.op = EER_IO_READ, .fd = file, .buffer = data,
+ *                            .size = sizeof(data), .offset = 0};
+ *
+ * eer_io_init(&io, 64, EER_IO_URING);
+ * eer_loop_io(&main_loop, &io);
+ * eer_io_submit(&io, &chunk);
+ * loop_on(&main_loop) {
+ *     eer_io_receive(Parser, parser, chunk);
+ * }
+ * ```
+ *
+ * The io_uring backend talks to the kernel through raw syscalls: queueing
+ * writes a submission entry in shared memory, and one io_uring_enter() per
+ * iteration submits everything queued. Completions are read from shared
+ * memory without a syscall. Where io_uring is unavailable the context
+ * falls back to an epoll set: streams are read or written once epoll
+ * reports them ready, regular files are accessed directly when reaped.
+ */
+
+enum eer_io_backend { EER_IO_URING, EER_IO_EPOLL };
+
+enum eer_io_op { EER_IO_READ, EER_IO_WRITE };
+
+typedef struct eer_io_request {
+    enum eer_io_op         op;
+    int                    fd;
+    void                  *buffer;
+    size_t                 size;
+    int64_t                offset; /* -1 for the current position */
+    int64_t                result; /* Bytes transferred or -errno */
+    bool                   done;   /* Completed, cleared by the component */
+    bool                   busy;   /* Submitted and not completed yet */
+    bool                   direct; /* Not pollable, epoll backend only */
+    struct eer_io_request *next;   /* Pending list, epoll backend only */
+} eer_io_request_t;
+
+typedef struct eer_io {
+    enum eer_io_backend backend;
+    struct eer_watch    watch;    /* Readable when completions may be reaped */
+    uint32_t            queued;   /* Submitted since the last reap */
+    uint32_t            inflight; /* Submitted and not completed */
+    uint64_t            syscalls; /* Syscalls spent on I/O */
+
+    /* io_uring */
+    uint32_t            *sq_head, *sq_tail, *sq_mask, *sq_array;
+    uint32_t            *cq_head, *cq_tail, *cq_mask;
+    void                *sqes;
+    void                *cqes;
+    void                *sq_ring, *cq_ring;
+    size_t               sq_size, cq_size, sqes_size;
+    uint32_t             entries;
+
+    /* epoll */
+    eer_io_request_t    *pending;
+} eer_io_t;
+
+/**
+ * @brief Open an I/O context for up to `entries` requests in flight
+ * @param io The context
+ * @param entries Submission queue size, a power of two
+ * @param backend EER_IO_URING tries io_uring first, EER_IO_EPOLL forces the
+ *        fallback
+ * @return OK or ERROR_UNKNOWN when neither backend is available
+ */
+eer_result_t eer_io_init(eer_io_t *io, uint32_t entries,
+                         enum eer_io_backend backend);
+
+/**
+ * @brief Close the context, requests in flight are abandoned
+ */
+void eer_io_release(eer_io_t *io);
+
+/**
+ * @brief Queue a request, no syscall is made until the next reap
+ * @return OK, ERROR_BUFFER_FULL when `entries` requests are in flight or
+ *         ERROR_BUFFER_BUSY when the request itself is still in flight
+ */
+eer_result_t eer_io_submit(eer_io_t *io, eer_io_request_t *request);
+
+/**
+ * @brief Submit the queued requests and collect completions, marking their
+ *        requests done. Called by the loop once per iteration.
+ * @return Number of completed requests
+ */
+size_t eer_io_reap(eer_io_t *io);
+
+/**
+ * @brief Update a component when its request completed, otherwise only
+ *        mount or unmount it when needed
+ *
+ * The component reads `result` in its hooks, clears `done` and may submit
+ * the request again.
+ *
+ * @param Type The component type
+ * @param name The component instance
+ * @param request The eer_io_request_t the component waits for
+ */
+#define eer_io_receive(Type, name, request)                                    \
+    eer_react_when(name, (request).done)
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "eer_histogram.h"
+#include "eer_ring.h"
+#include <stdint.h>
+
+/**
+ * @file eer_irq.h
+ * @brief Simulated interrupt controller for the Linux simulation
+ *
+ * A controller thread stands in for the interrupt hardware. IRQ lines are
+ * raised by a periodic timerfd or by eer_irq_raise(), which only writes an
+ * eventfd and may be called from a signal handler. The controller runs the
+ * line handler in "interrupt context": a handler must not touch components
+ * and may only post into lock-free mailboxes, typically with eer_irq_post()
+ * into an eer_ring_t read by receive().
+ *
+ * Every event carries the time it was raised, so the loop can measure the
+ * latency from the IRQ to the did_update of the component that handled it:
+ *
+ * ```c
+ * eer_ring(eer_irq_event_t, button_irq, 64);
+ *
+ * eer_irq_attach(3, eer_irq_post, &button_irq);
+ * eer_irq_start();
+ *
+ * DID_UPDATE(Button) {
+ *     eer_histogram_add(&latency, eer_irq_latency(&state->event));
+ * }
+ * ```
+ *
+ * Timestamps are nanoseconds of CLOCK_MONOTONIC, also when the simulation
+ * clock runs in fast mode: interrupts model real elapsed time.
+ */
+
+#define EER_IRQ_LINES 16
+
+typedef struct eer_irq_event {
+    uint64_t raised; /* CLOCK_MONOTONIC nanoseconds */
+    uint32_t count;  /* Raises coalesced into this event */
+    uint8_t  line;
+} eer_irq_event_t;
+
+typedef void (*eer_irq_handler_t)(const eer_irq_event_t *event,
+                                  void                  *argument);
+
+/**
+ * @brief Handler that copies the event into the eer_ring_t of eer_irq_event_t
+ *        passed as argument, counting drops when it is full
+ */
+void eer_irq_post(const eer_irq_event_t *event, void *mailbox);
+
+/**
+ * @brief Connect a handler to an IRQ line
+ * @return OK, ERROR_BUFFER_BUSY when the line is taken or ERROR_UNKNOWN
+ */
+eer_result_t eer_irq_attach(uint8_t line, eer_irq_handler_t handler,
+                            void *argument);
+
+/**
+ * @brief Raise an IRQ line every `period` microseconds, 0 disarms the timer
+ * @return OK or ERROR_UNKNOWN
+ */
+eer_result_t eer_irq_timer(uint8_t line, uint64_t period);
+
+/**
+ * @brief Raise an IRQ line once, async-signal-safe
+ * @return OK or ERROR_UNKNOWN when the line is not attached
+ */
+eer_result_t eer_irq_raise(uint8_t line);
+
+/**
+ * @brief Start the controller thread
+ * @return OK, ERROR_BUFFER_BUSY when running or ERROR_UNKNOWN
+ */
+eer_result_t eer_irq_start(void);
+
+/** @brief Stop the controller thread and release every line */
+void eer_irq_stop(void);
+
+/** @brief Events lost because a mailbox was full */
+uint64_t eer_irq_dropped(void);
+
+/** @brief CLOCK_MONOTONIC nanoseconds */
+uint64_t eer_irq_now(void);
+
+/** @brief Nanoseconds elapsed since the event was raised */
+static inline uint64_t eer_irq_latency(const eer_irq_event_t *event)
+{
+    return eer_irq_now() - event->raised;
+}
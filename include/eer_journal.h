@@ -0,0 +1,129 @@
+#pragma once
+
+#include "eer.h"
+#include "eer_hal.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file eer_journal.h
+ * @brief Wear-leveled flash journal of component state
+ *
+ * Rewriting a whole component to flash after every update is slow and
+ * wears the sectors out. A journal keeps the last persisted copy of every
+ * listed component and eer_journal_commit() appends only the byte ranges
+ * that changed since, as small records, to the active sector of hw(flash).
+ *
+ * ```c
+ * eer_journal(settings, 4, 512);
+ *
+ * eer_journal_add(&settings, Thermostat, thermostat);
+ * if (OK != eer_journal_open(&settings, 0, 8))
+ *     log_info("no saved state");
+ * loop_on(&main_loop, thermostat) {
+ *     eer_journal_commit(&settings);
+ * }
+ * ```
+ *
+ * When the active sector is full the journal compacts: it takes the least
+ * erased of its other sectors, erases it and writes a checkpoint with the
+ * full copy of every component, after which the old sector is garbage.
+ * Sectors are chosen by the erase count kept in their header, so erases
+ * spread evenly over the region.
+ *
+ * The last record of a commit is flagged and every record carries a
+ * checksum: eer_journal_open() replays the sector with the newest complete
+ * checkpoint up to its last complete commit, so a power cut loses at most
+ * the commit it interrupted, never half of one. Like snapshots, components
+ * are restored as bytes into RELEASED without mount hooks, their props and
+ * state must hold no pointers or handles. Versions are not journaled, a
+ * restore bumps them so eer_changed() readers see the restored state.
+ */
+
+#define EER_JOURNAL_MAGIC  0x4a524545u /* "EERJ" */
+#define EER_JOURNAL_RECORD 128         /* Largest record in bytes */
+#define EER_JOURNAL_NONE   UINT16_MAX  /* No active sector */
+
+/** @brief Component listed in a journal */
+struct eer_journal_entry {
+    eer_t   *instance;
+    uint8_t *data;   /* Props followed by state */
+    uint8_t *shadow; /* Copy of the data as persisted */
+    size_t   size;
+};
+
+typedef struct eer_journal {
+    struct eer_journal_entry *entries;
+    size_t                    count;
+    size_t                    capacity;
+    uint8_t                  *pool; /* Storage of the shadows */
+    size_t                    pool_size;
+    size_t                    pool_used;
+    uint32_t                  layout; /* Hash of names and sizes */
+
+    uint16_t first;    /* First sector of the region */
+    uint16_t sectors;  /* Sectors in the region */
+    uint32_t sector_size;
+    uint16_t active;   /* Sector appended to or EER_JOURNAL_NONE */
+    uint32_t position; /* Next record in the active sector */
+    uint32_t sequence; /* Of the active sector */
+
+    uint64_t commits;     /* Commits that wrote records */
+    uint64_t records;     /* Delta records */
+    uint64_t changed;     /* Changed bytes carried by delta records */
+    uint64_t written;     /* Bytes programmed, checkpoints included */
+    uint64_t compactions; /* Checkpoints written */
+    uint64_t erases;
+} eer_journal_t;
+
+/**
+ * @brief Defines a journal with static storage
+ * @param name The journal name
+ * @param capacity Maximum number of components, at most 255
+ * @param pool Bytes for the persisted copies, the sum of the component sizes
+ */
+#define eer_journal(name, capacity_size, pool_bytes)                           \
+    struct eer_journal_entry name##_entries[capacity_size];                    \
+    uint8_t                  name##_pool[pool_bytes];                          \
+    eer_journal_t            name = {.entries   = name##_entries,              \
+                                     .capacity  = capacity_size,               \
+                                     .pool      = name##_pool,                 \
+                                     .pool_size = pool_bytes,                  \
+                                     .active    = EER_JOURNAL_NONE}
+
+/**
+ * @brief List component `name` of type `Type` in a journal, before
+ *        eer_journal_open()
+ * @return OK or ERROR_BUFFER_FULL
+ */
+#define eer_journal_add(journal, Type, name)                                   \
+    eer_journal_register(journal, &(name).instance, &(name).props,            \
+                         sizeof(Type##_t) - offsetof(Type##_t, props), #name)
+
+eer_result_t eer_journal_register(eer_journal_t *journal, eer_t *instance,
+                                  void *data, size_t size, const char *name);
+
+/**
+ * @brief Take sectors `first` to `first + sectors - 1` of hw(flash) and
+ *        restore the listed components from them
+ * @return OK when the components were restored, ERROR_UNKNOWN when the
+ *         region holds no state of these components, which are then left
+ *         untouched, or ERROR_BUFFER_FULL when a checkpoint would take more
+ *         than half a sector or the region is not at least two sectors
+ */
+eer_result_t eer_journal_open(eer_journal_t *journal, uint16_t first,
+                              uint16_t sectors);
+
+/**
+ * @brief Append the bytes that changed since the last commit, compacting
+ *        when the active sector is full
+ * @return OK or ERROR_UNKNOWN when the flash failed, the next commit then
+ *         writes a checkpoint
+ */
+eer_result_t eer_journal_commit(eer_journal_t *journal);
+
+/**
+ * @brief Write a checkpoint to a fresh sector now
+ */
+eer_result_t eer_journal_compact(eer_journal_t *journal);
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "eer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file eer_keyed.h
+ * @brief Keyed children reconciled against a new list of keys
+ *
+ * Rebuilding a dynamic collection by shutting every component and mounting
+ * it again runs did_unmount, will_mount and did_mount for items that did not
+ * change. A keyed collection owns a pool of children identified by keys.
+ * eer_keyed_reconcile() takes the new list of keys in display order and
+ * diffs it against the current one:
+ *
+ * - keys that disappeared unmount their child, new keys mount one
+ * - kept keys update only when their props changed and should_update agrees;
+ *   props are compared byte by byte, so their type must have no padding
+ * - the longest increasing subsequence of the kept keys' old positions stays
+ *   in place, the other kept keys are reported as moved, the smallest set of
+ *   moves that restores the new order
+ *
+ * ```c
+ * void task_props(void *context, size_t index, uint64_t key, void *props)
+ * {
+ *     *(Task_props_t *)props = (Task_props_t){.task = find_task(key)};
+ * }
+ *
+ * eer_keyed(Task, tasks, 1024, task_props, NULL);
+ *
+ * loop_on(&main_loop) {
+ *     if (tasks_changed)
+ *         eer_keyed_reconcile(&tasks, task_ids, task_count);
+ * }
+ * ```
+ *
+ * Lifecycle hooks run for changes only. Each reconcile still walks the new
+ * keys once, through a hash table that is reset by a generation counter
+ * rather than cleared.
+ */
+
+#define EER_KEYED_NONE UINT32_MAX /* Position or slot without an entry */
+
+/**
+ * @brief Write the props of the child with `key`, shown at `index`
+ */
+typedef void (*eer_keyed_props_t)(void *context, size_t index, uint64_t key,
+                                  void *props);
+
+/**
+ * @brief Called for a kept child that changed its place among the others
+ */
+typedef void (*eer_keyed_move_t)(void *context, eer_t *child, size_t from,
+                                 size_t to);
+
+/** @brief Hash table entry, valid while `generation` matches */
+struct eer_keyed_entry {
+    uint32_t value; /* Old position, or capacity + new index for new keys */
+    uint32_t generation;
+};
+
+typedef struct eer_keyed {
+    size_t            capacity;
+    size_t            count; /* Children in display order */
+    eer_keyed_props_t props;
+    eer_keyed_move_t  move;  /* Optional */
+    void             *context;
+
+    eer_t     prototype;    /* Lifecycle of the child type, copied to slots */
+    uint8_t  *children;     /* `capacity` children of the child type */
+    size_t    stride;       /* Size of one child */
+    size_t    props_offset; /* Offset of the props in a child */
+    size_t    props_size;
+    void     *next_props;   /* Props written by `props` */
+
+    uint64_t *keys;     /* Key of each slot */
+    uint32_t *order;    /* Slot of each position */
+    uint32_t *free;     /* Stack of unused slots */
+    size_t    free_count;
+    bool      ready;
+
+    /* Reconcile scratch */
+    struct eer_keyed_entry *table; /* 2 * capacity entries */
+    uint32_t                generation;
+    uint32_t               *sources;  /* Old position of each new position */
+    uint32_t               *targets;  /* New position of each old position */
+    uint32_t               *tails;    /* Longest increasing subsequence */
+    uint32_t               *previous;
+    uint32_t               *next_order;
+
+    uint64_t mounts;
+    uint64_t unmounts;
+    uint64_t updates;
+    uint64_t moves;
+} eer_keyed_t;
+
+/**
+ * @brief Defines a keyed collection with static storage for `capacity`
+ *        children of `Type`
+ * @param Type The child component type
+ * @param name The collection name
+ * @param capacity Maximum number of children
+ * @param child_props eer_keyed_props_t writing the props of a child
+ * @param child_context Passed to `child_props`
+ */
+#define eer_keyed(Type, name, capacity_size, child_props, child_context)       \
+    Type##_t               name##_children[capacity_size];                     \
+    uint64_t               name##_keys[capacity_size];                         \
+    uint32_t               name##_order[capacity_size];                        \
+    uint32_t               name##_free[capacity_size];                         \
+    struct eer_keyed_entry name##_table[2 * (capacity_size)];                  \
+    uint32_t               name##_sources[capacity_size];                      \
+    uint32_t               name##_targets[capacity_size];                      \
+    uint32_t               name##_tails[capacity_size];                        \
+    uint32_t               name##_previous[capacity_size];                     \
+    uint32_t               name##_next_order[capacity_size];                   \
+    Type##_props_t         name##_next_props;                                  \
+    eer_keyed_t            name = {.capacity     = capacity_size,              \
+                                   .props        = child_props,                \
+                                   .context      = child_context,              \
+                                   .prototype    = eer_define_component(Type,  \
+                                                                        name), \
+                                   .children     = (uint8_t *)name##_children, \
+                                   .stride       = sizeof(Type##_t),           \
+                                   .props_offset = offsetof(Type##_t, props),  \
+                                   .props_size   = sizeof(Type##_props_t),     \
+                                   .next_props   = &name##_next_props,         \
+                                   .keys         = name##_keys,                \
+                                   .order        = name##_order,               \
+                                   .free         = name##_free,                \
+                                   .table        = name##_table,               \
+                                   .sources      = name##_sources,             \
+                                   .targets      = name##_targets,             \
+                                   .tails        = name##_tails,               \
+                                   .previous     = name##_previous,            \
+                                   .next_order   = name##_next_order}
+
+/**
+ * @brief Child shown at `position`
+ */
+static inline eer_t *eer_keyed_child(eer_keyed_t *keyed, size_t position)
+{
+    return (eer_t *)(keyed->children
+                     + (size_t)keyed->order[position] * keyed->stride);
+}
+
+/**
+ * @brief Key of the child shown at `position`
+ */
+static inline uint64_t eer_keyed_key(eer_keyed_t *keyed, size_t position)
+{
+    return keyed->keys[keyed->order[position]];
+}
+
+/**
+ * @brief Make the children follow `keys`, in that order
+ * @return OK, ERROR_BUFFER_FULL when `count` exceeds the capacity or
+ *         ERROR_UNKNOWN when a key repeats; the collection is unchanged on
+ *         error
+ */
+eer_result_t eer_keyed_reconcile(eer_keyed_t *keyed, const uint64_t *keys,
+                                 size_t count);
+
+/**
+ * @brief Unmount every child
+ */
+void eer_keyed_shut(eer_keyed_t *keyed);
@@ -47,6 +47,9 @@
 /** @brief Called when a component is unmounted. Use this for cleanup. */
 #define DID_UNMOUNT   eer_did_unmount
 
+/** @brief will_update, release and did_update as one hook. Replaces all three. */
+#define UPDATE        eer_update
+
 /** @} */ // end of lifecycle_hooks group
 
 /**
@@ -249,6 +252,37 @@
  */
 #define eer_did_unmount(Type)   eer_lifecycle(Type, did_unmount)
 
+/**
+ * @brief Define a fused update method
+ * @param Type The component type
+ *
+ * Replaces will_update, release and did_update for components whose update
+ * is a single step. The body runs with the new props already in `props`.
+ * Release is generated to run the body and to install Type##_update into the
+ * instance, after which eer_staging makes one call per update instead of
+ * three.
+ */
+#define eer_update(Type)                                                       \
+    eer_lifecycle_header(Type, update);                                        \
+    void Type##_update(void *instance, void *next_props_ptr)                   \
+    {                                                                          \
+        eer_self(Type, instance);                                              \
+        if (next_props_ptr && &self->props != next_props_ptr)                  \
+            self->props = *(Type##_props_t *)next_props_ptr;                   \
+        eer_lifecycle_prepare(Type, instance, release);                        \
+        Type##_inline_update(&self->instance, &self->props, &self->state);     \
+        eer_lifecycle_finish(Type, instance, release);                         \
+    }                                                                          \
+    eer_will_update_skip(Type)                                                 \
+    void Type##_release(void *instance)                                        \
+    {                                                                          \
+        eer_self(Type, instance);                                              \
+        self->instance.update = Type##_update;                                 \
+        Type##_update(instance, 0);                                            \
+    }                                                                          \
+    eer_did_update_skip(Type)                                                  \
+    eer_lifecycle_header(Type, update)
+
 /* Skip lifecycle implementations */
 
 /**
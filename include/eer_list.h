@@ -0,0 +1,123 @@
+#pragma once
+
+#include "eer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file eer_list.h
+ * @brief Virtualized list that only mounts the visible items
+ *
+ * A list of thousands of entries cannot afford one component per entry. A
+ * virtualized list owns one child component per visible row, a window over
+ * the items starting at `offset`. Item `i` lives in slot `i % window`, so
+ * scrolling by a few rows rebinds only the slots whose items left the
+ * viewport: the child stays mounted and updates with the props of the item
+ * that entered. Memory and work per iteration depend on the window, not on
+ * `count`.
+ *
+ * Props come from a callback called for each visible item once per
+ * iteration. Children whose item did not change update only when their
+ * props differ and should_update agrees. Props are compared byte by byte,
+ * so the props type of the children must have no padding.
+ *
+ * ```c
+ * void file_row(void *context, size_t index, uint16_t row, void *props)
+ * {
+ *     *(FileRow_props_t *)props
+ *         = (FileRow_props_t){.row = row, .name = files[index].name};
+ * }
+ *
+ * eer_list(FileRow, browser, 20, file_row, NULL);
+ *
+ * loop_on(&main_loop) {
+ *     eer_list_scroll(&browser, cursor > 10 ? cursor - 10 : 0);
+ *     eer_list_staging(&browser);
+ * }
+ * ```
+ */
+
+#define EER_LIST_NONE SIZE_MAX /* Slot without an item */
+
+/**
+ * @brief Write the props of item `index`, shown at viewport `row`
+ */
+typedef void (*eer_list_item_t)(void *context, size_t index, uint16_t row,
+                                void *props);
+
+typedef struct eer_list {
+    size_t          count;   /* Items in the list */
+    size_t          offset;  /* First visible item */
+    uint16_t        window;  /* Visible rows, one child per row */
+    eer_list_item_t item;
+    void           *context;
+
+    eer_t     prototype;   /* Lifecycle of the child type, copied to slots */
+    uint8_t  *children;    /* `window` children of the child type */
+    size_t    stride;      /* Size of one child */
+    size_t    props_offset; /* Offset of the props in a child */
+    size_t    props_size;
+    void     *next_props;  /* Props written by `item` */
+    size_t   *bound;       /* Item shown by each slot */
+    bool      ready;
+
+    uint64_t mounts;   /* Slots that got an item */
+    uint64_t unmounts; /* Slots that lost their item */
+    uint64_t recycles; /* Mounted slots that switched to another item */
+    uint64_t updates;  /* Children updated with new props of their item */
+} eer_list_t;
+
+/**
+ * @brief Defines a list of `Type` children with static storage for a
+ *        `window` of visible rows
+ * @param Type The child component type
+ * @param name The list name
+ * @param window Number of visible rows
+ * @param item eer_list_item_t writing the props of an item
+ * @param context Passed to `item`
+ */
+#define eer_list(Type, name, window_size, item_props, item_context)            \
+    Type##_t       name##_children[window_size];                               \
+    size_t         name##_bound[window_size];                                  \
+    Type##_props_t name##_next_props;                                          \
+    eer_list_t     name = {.window       = window_size,                        \
+                           .item         = item_props,                         \
+                           .context      = item_context,                       \
+                           .prototype    = eer_define_component(Type, name),   \
+                           .children     = (uint8_t *)name##_children,         \
+                           .stride       = sizeof(Type##_t),                   \
+                           .props_offset = offsetof(Type##_t, props),          \
+                           .props_size   = sizeof(Type##_props_t),             \
+                           .next_props   = &name##_next_props,                 \
+                           .bound        = name##_bound}
+
+/**
+ * @brief Child component of a slot
+ */
+static inline eer_t *eer_list_child(eer_list_t *list, uint16_t slot)
+{
+    return (eer_t *)(list->children + (size_t)slot * list->stride);
+}
+
+/**
+ * @brief Set the number of items, the offset is clamped to the new count
+ */
+void eer_list_resize(eer_list_t *list, size_t count);
+
+/**
+ * @brief Move the viewport, clamped so the window stays within the items
+ */
+void eer_list_scroll(eer_list_t *list, size_t offset);
+
+/**
+ * @brief Mount, recycle, update or unmount the children for the viewport
+ * @return EER_CONTEXT_UPDATED when a child changed, EER_CONTEXT_SAME
+ *         otherwise or for a list without rows
+ */
+enum eer_context eer_list_staging(eer_list_t *list);
+
+/**
+ * @brief Unmount every child
+ */
+void eer_list_shut(eer_list_t *list);
@@ -0,0 +1,230 @@
+#pragma once
+
+#include "eer.h"
+#include "eer_hal.h"
+#include "eer_histogram.h"
+#include "eer_idle.h"
+#include "eer_io.h"
+#include "eer_realtime.h"
+#include "eer_registry.h"
+#include "eer_ring.h"
+
+/**
+ * @file eer_loop.h
+ * @brief Reentrant event loop objects
+ *
+ * loop() keeps its state in a local `eer_land` and jumps to a fixed
+ * `eer_boot` label, so only one loop fits in a function and nothing can
+ * observe it from another thread. An eer_loop_t holds the loop state
+ * explicitly: context, iteration counter, hooks and the registry it
+ * schedules. Every thread can run its own loop object, which lets
+ * components be sharded across cores.
+ *
+ * Example:
+ * ```c
+ * eer_registry(core0_components, 256);
+ * eer_loop_t core0;
+ *
+ * void *core0_thread(void *argument)
+ * {
+ *     eer_loop_init(&core0, &core0_components);
+ *     loop_on(&core0) {
+ *         apply(Filter, filter, _({.sample = read_sample()}));
+ *     }
+ *     return NULL;
+ * }
+ * ```
+ */
+
+/** @brief Points of the loop where hooks run */
+enum eer_loop_event {
+    EER_LOOP_ON_START,
+    EER_LOOP_ON_ITERATION,
+    EER_LOOP_ON_EXIT
+};
+
+#define EER_LOOP_HOOKS 8
+
+struct eer_loop_hook {
+    enum eer_loop_event event;
+    eer_callback_t      callback; /* Called with the loop as trigger */
+};
+
+typedef struct eer_loop {
+    union eer_land         land;
+    uint64_t               iteration;
+    uint8_t                stopping;
+    eer_registry_t        *registry; /* Staged after every iteration, optional */
+    struct eer_loop_hook   hooks[EER_LOOP_HOOKS];
+    uint8_t                hook_count;
+    eer_mpmc_t            *callbacks; /* Deferred eer_callback_t, optional */
+    size_t                 callback_budget; /* Per iteration, 0 is unlimited */
+    const eer_loop_attr_t *attr; /* Applied by the loop thread, optional */
+    uint8_t                realtime_failed; /* enum eer_realtime_step mask */
+    uint64_t               period;   /* Microseconds, 0 runs unpaced */
+    uint64_t               deadline; /* Start of the next iteration */
+    uint32_t               spin;     /* Busy-wait before the deadline, us */
+    uint64_t               overruns; /* Iterations that missed a deadline */
+    eer_histogram_t       *jitter;   /* Start lateness in us, optional */
+    eer_idle_t            *idle;     /* Waits between iterations, optional */
+    eer_io_t              *io;       /* Reaped after every iteration */
+} eer_loop_t;
+
+/**
+ * @brief Run an event loop on a loop object
+ *
+ * Works like loop(...): the listed components are staged before every
+ * iteration and the loop ends when they stop changing or when the body
+ * sets `eer_land.state.unmounted`. The loop state lives in the object, so
+ * any number of loops can run in one function or in different threads.
+ *
+ * @param loop Pointer to an initialized eer_loop_t
+ * @param ... Components staged on every iteration
+ */
+#define eer_loop_run(loop, ...)                                                \
+    for (union eer_land eer_land = eer_loop_begin(loop);                       \
+         eer_loop_running(                                                     \
+             loop, &eer_land,                                                  \
+             IF_ELSE(HAS_ARGS(__VA_ARGS__))((EVAL(MAP(                         \
+                 __eer_init, __VA_ARGS__)) EER_CONTEXT_SAME))(                 \
+                 EER_CONTEXT_UPDATED));                                        \
+         eer_loop_next(loop, &eer_land))
+
+/**
+ * @brief Run an event loop at a fixed rate
+ *
+ * Same as eer_loop_run() but every iteration starts on a grid of absolute
+ * deadlines `1/hz` apart, so the time spent in the body and in sleeping does
+ * not accumulate as drift. An iteration that runs past its deadline counts
+ * as an overrun, the next one starts immediately and the missed periods are
+ * skipped to stay in phase.
+ *
+ * ```c
+ * eer_histogram_t jitter = {0};
+ *
+ * eer_loop_spin(&control, 50);
+ * eer_loop_jitter(&control, &jitter);
+ * eer_loop_at(&control, 1000, Motor) {
+ *     apply(Motor, motor, _({.setpoint = read_encoder()}));
+ * }
+ * eer_histogram_report(&jitter, "control jitter us", stdout);
+ * ```
+ *
+ * @param loop Pointer to an initialized eer_loop_t
+ * @param hz Iterations per second, 0 runs unpaced, at most 1000000
+ * @param ... Components staged on every iteration
+ */
+#define eer_loop_at(loop, hz, ...)                                             \
+    for (bool eer_paced = (eer_loop_pace(loop, hz), true); eer_paced;          \
+         eer_paced      = false)                                               \
+    eer_loop_run(loop, __VA_ARGS__)
+
+void         eer_loop_init(eer_loop_t *loop, eer_registry_t *registry);
+eer_result_t eer_loop_hook(eer_loop_t *loop, enum eer_loop_event event,
+                           eer_callback_t callback);
+
+/**
+ * @brief Prepare the loop thread as described by `attr` before the first
+ *        iteration: CPU affinity, SCHED_FIFO, mlockall and prefaulting.
+ *        Steps that fail are left in loop->realtime_failed.
+ * @param loop The loop
+ * @param attr Attributes, must outlive the loop run
+ */
+void eer_loop_configure(eer_loop_t *loop, const eer_loop_attr_t *attr);
+
+/**
+ * @brief Pace the loop at `hz` iterations per second, 0 runs unpaced.
+ *        Rates above 1 MHz are clamped to one iteration per microsecond.
+ */
+void eer_loop_pace(eer_loop_t *loop, uint32_t hz);
+
+/**
+ * @brief Busy-wait the last `us` microseconds before every deadline
+ *
+ * Sleeping wakes up late by the scheduler latency. Waking `us` earlier and
+ * spinning to the deadline trades CPU time for jitter below that latency.
+ */
+void eer_loop_spin(eer_loop_t *loop, uint32_t us);
+
+/**
+ * @brief Record how late every paced iteration starts, in microseconds,
+ *        overruns included
+ */
+void eer_loop_jitter(eer_loop_t *loop, eer_histogram_t *histogram);
+
+/**
+ * @brief Wait on `idle` after every iteration of an unpaced loop
+ *
+ * The loop spins, yields and then blocks until eer_loop_wake(), see
+ * eer_idle.h. Producers feeding the loop through channels or rings call
+ * eer_loop_wake() after sending, eer_loop_defer() and eer_loop_stop() wake
+ * the loop themselves. An iteration that leaves a component PREPARED, like
+ * apply() does, goes on without waiting so the component releases at once.
+ *
+ * @param loop The loop
+ * @param idle Idle object prepared with eer_idle_init()
+ */
+void eer_loop_idle(eer_loop_t *loop, eer_idle_t *idle);
+
+/**
+ * @brief Signal new work to an idle loop, safe to call from any thread
+ */
+void eer_loop_wake(eer_loop_t *loop);
+
+/**
+ * @brief Collect readiness of a descriptor in the epoll set of the loop
+ * @return OK or ERROR_UNKNOWN when the loop has no idle object or the
+ *         descriptor cannot be watched
+ */
+eer_result_t eer_loop_watch(eer_loop_t *loop, struct eer_watch *watch);
+void         eer_loop_unwatch(eer_loop_t *loop, struct eer_watch *watch);
+
+/**
+ * @brief Submit and reap the requests of an I/O context once per iteration
+ *
+ * Completions are reaped after the registry and deferred callbacks, and the
+ * loop does not idle after an iteration that completed requests. Attach the
+ * idle object first so that completions also wake a blocked loop.
+ *
+ * @param loop The loop
+ * @param io Context prepared with eer_io_init()
+ */
+void eer_loop_io(eer_loop_t *loop, eer_io_t *io);
+
+/**
+ * @brief Attach a deferred callback queue to a loop
+ *
+ * Callbacks queued with eer_loop_defer() run on the loop thread after the
+ * registry is staged, before the iteration hooks. At most `budget` of them
+ * run per iteration, the rest wait for the next one. Callbacks queued while
+ * the queue drains also wait, so every iteration does bounded work.
+ *
+ * @param loop The loop
+ * @param queue MPMC ring of eer_callback_t, see eer_mpmc()
+ * @param budget Callbacks per iteration, 0 drains what was queued
+ */
+void eer_loop_callbacks(eer_loop_t *loop, eer_mpmc_t *queue, size_t budget);
+
+/**
+ * @brief Run a callback in a later iteration of the loop, safe to call from
+ *        any thread
+ * @return OK, ERROR_BUFFER_FULL or ERROR_UNKNOWN without a queue
+ */
+eer_result_t eer_loop_defer(eer_loop_t *loop, eer_callback_t callback);
+
+/**
+ * @brief Ask a loop to exit after its current iteration, safe to call from
+ *        any thread
+ */
+void eer_loop_stop(eer_loop_t *loop);
+
+/**
+ * @brief Number of completed iterations, safe to read from any thread
+ */
+uint64_t eer_loop_iteration(eer_loop_t *loop);
+
+/* Used by eer_loop_run */
+union eer_land eer_loop_begin(eer_loop_t *loop);
+bool           eer_loop_running(eer_loop_t *loop, union eer_land *land,
+                                enum eer_context context);
+void           eer_loop_next(eer_loop_t *loop, union eer_land *land);
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "eer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file eer_node.h
+ * @brief Parent/child component trees with subtree skipping
+ *
+ * Components are staged one by one, even when the component they depend on
+ * did not change. A node places a component in a tree: its props are
+ * derived from the state of its parent by a callback, and
+ * eer_node_staging() walks the tree from a root, descending only into the
+ * children of components that mounted or updated. A parent whose
+ * should_update returned false, or that had nothing to do, skips its whole
+ * subtree for that iteration. A child whose derived props are unchanged, or
+ * whose should_update refuses them, skips its own subtree in turn.
+ *
+ * ```c
+ * void row_props(eer_t *parent, void *props)
+ * {
+ *     Table_t *table = (Table_t *)parent;
+ *
+ *     *(Row_props_t *)props = (Row_props_t){.value = table->state.total};
+ * }
+ *
+ * eer_withprops(Table, table, _({.source = &samples}));
+ * eer_withprops(Row, total, _({0}));
+ * eer_node(Table, table, NULL);
+ * eer_node(Row, total, row_props);
+ *
+ * eer_node_attach(&table_node, &total_node);
+ * loop_on(&main_loop) {
+ *     eer_node_staging(&table_node, &(Table_props_t){.source = &samples});
+ * }
+ * ```
+ *
+ * A component counts as changed when its version moved since the last walk,
+ * so a react() on a component of the tree from outside also updates its
+ * subtree. Skipped subtrees are still walked to finish pending stages:
+ * children attached after the first walk mount, updates left PREPARED by
+ * apply() release and changed components update their own subtrees. That
+ * walk reads a stage and a version per node and runs no hooks for the
+ * others.
+ */
+
+/**
+ * @brief Write the props of a child from the state of its parent
+ */
+typedef void (*eer_node_props_t)(eer_t *parent, void *props);
+
+typedef struct eer_node {
+    eer_t            *instance;
+    struct eer_node  *parent;
+    struct eer_node  *child;   /* First child */
+    struct eer_node  *sibling; /* Next child of the parent */
+    eer_node_props_t  props;   /* NULL for roots */
+    void             *current; /* Props of the component */
+    void             *next;    /* Props written by `props` */
+    size_t            size;    /* Size of the props */
+    uint32_t          version; /* Version of the component at the last walk */
+
+    uint64_t updates; /* Iterations that mounted or updated the component */
+    uint64_t skips;   /* Iterations the subtree below it was skipped */
+} eer_node_t;
+
+/**
+ * @brief Defines `name##_node`, the tree node of component `name`
+ * @param Type The component type
+ * @param name The component instance
+ * @param derive eer_node_props_t of the component, NULL for a root
+ */
+#define eer_node(Type, name, derive)                                           \
+    eer_node_t name##_node = {.instance = &name.instance,                      \
+                              .props    = derive,                              \
+                              .current  = &name.props,                         \
+                              .next     = &(Type##_props_t){0},                \
+                              .size     = sizeof(Type##_props_t)}
+
+/**
+ * @brief Append `child` to the children of `parent`
+ */
+void eer_node_attach(eer_node_t *parent, eer_node_t *child);
+
+/**
+ * @brief Stage the component of `root`, then the subtrees of the components
+ *        that were released since the last walk
+ *
+ * The root mounts, finishes an update left pending by apply() or react(),
+ * and updates when `next_props` differ from its props and should_update
+ * agrees. Children are staged the same way with the props derived from
+ * their parent.
+ *
+ * @param root The root node
+ * @param next_props New props of the root, NULL keeps them
+ * @return Number of components released since the last walk
+ */
+size_t eer_node_staging(eer_node_t *root, void *next_props);
+
+/**
+ * @brief Unmount the subtree, children before their parent
+ */
+void eer_node_shut(eer_node_t *node);
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "eer.h"
+#include "eer_hal.h"
+
+/**
+ * @file eer_rate.h
+ * @brief Throttle, debounce and sampling policies for react()
+ *
+ * react() runs will_update, release and did_update on every call, so a fast
+ * producer drives every update of a slow consumer. A limiter keeps the
+ * latest props of a component and lets a policy decide when they reach it:
+ *
+ * - EER_RATE_THROTTLE: the first react runs at once, later ones within the
+ *   interval collapse into one trailing update at the end of the interval.
+ * - EER_RATE_DEBOUNCE: the update runs once reacts have been quiet for the
+ *   interval.
+ * - EER_RATE_SAMPLE: the latest props are applied once per interval.
+ *
+ * Example:
+ * ```c
+ * eer_limiter(Gauge, gauge, EER_RATE_THROTTLE, 16667); // 60 Hz
+ *
+ * loop() {
+ *     if (adc_ready())
+ *         react_limited(Gauge, gauge, _({.value = adc_read()}));
+ *     flush_limited(Gauge, gauge);
+ * }
+ * ```
+ */
+
+enum eer_rate_policy { EER_RATE_THROTTLE, EER_RATE_DEBOUNCE, EER_RATE_SAMPLE };
+
+typedef struct eer_rate {
+    enum eer_rate_policy policy;
+    uint32_t             interval_us;
+    uint64_t             last_us; /* Last update, last react for debounce */
+    bool                 pending; /* Collapsed props wait for an update */
+    bool                 started;
+} eer_rate_t;
+
+/**
+ * @brief Defines the rate state and pending props of a component
+ * @param Type The component type
+ * @param name The component instance
+ * @param policy enum eer_rate_policy
+ * @param interval Interval in microseconds
+ */
+#define eer_limiter(Type, name, policy, interval)                              \
+    Type##_props_t name##_pending;                                             \
+    eer_rate_t     name##_rate = {policy, interval, 0, false, false}
+
+/**
+ * @brief react() through the limiter of a component
+ *
+ * The props are kept as pending and the component updates only when the
+ * policy allows it, either now or later from eer_flush_limited().
+ */
+#define eer_react_limited(Type, name, propsValue)                              \
+    {                                                                          \
+        name##_pending = (Type##_props_t)propsValue;                           \
+        if (eer_rate_request(&name##_rate, eer_now_us()))                      \
+            eer_react(Type, name, name##_pending);                             \
+    }
+
+/**
+ * @brief Stage a limited component, running its collapsed update when due.
+ *        Call it on every iteration, the component is otherwise only
+ *        mounted or unmounted.
+ */
+#define eer_flush_limited(Type, name)                                          \
+    if (eer_rate_due(&name##_rate, eer_now_us())) {                            \
+        eer_react(Type, name, name##_pending);                                 \
+    } else {                                                                   \
+        eer_keep(name);                                                        \
+    }
+
+/**
+ * @brief Record a react at `now`
+ * @return true when the update should run immediately
+ */
+bool eer_rate_request(eer_rate_t *rate, uint64_t now);
+
+/**
+ * @brief Check for a collapsed update at `now`
+ * @return true when the pending update should run now
+ */
+bool eer_rate_due(eer_rate_t *rate, uint64_t now);
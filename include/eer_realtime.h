@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file eer_realtime.h
+ * @brief Real-time placement of loop and worker threads
+ *
+ * Page faults and migrations to another CPU are the usual sources of tail
+ * latency in a loop iteration. A loop attribute struct describes how the
+ * thread that runs a loop should be prepared before its first iteration:
+ * pinned to a set of CPUs, moved to SCHED_FIFO, with all memory locked and
+ * the stack and pools prefaulted.
+ *
+ * ```c
+ * struct eer_region pools[] = {{samples, sizeof(samples)}};
+ * eer_loop_attr_t   attr    = {.cpus          = 1 << 2,
+ *                              .priority      = 80,
+ *                              .lock_memory   = true,
+ *                              .prefault_stack = 256 * 1024,
+ *                              .regions       = pools,
+ *                              .region_count  = 1};
+ *
+ * eer_loop_configure(&core2, &attr);
+ * loop_on(&core2) { ... }
+ * ```
+ *
+ * Worker threads apply the same struct with eer_realtime_apply(). SCHED_FIFO
+ * and mlockall need CAP_SYS_NICE and CAP_IPC_LOCK or matching rlimits, a
+ * step that is refused is reported and the remaining steps still run.
+ * Outside Linux every requested step is reported as failed.
+ */
+
+/** @brief Memory to prefault */
+struct eer_region {
+    void  *address;
+    size_t size;
+};
+
+typedef struct eer_loop_attr {
+    uint64_t           cpus;     /* CPU mask, 0 keeps the current affinity */
+    int                priority; /* SCHED_FIFO priority, 0 keeps the policy */
+    bool               lock_memory;    /* mlockall current and future pages */
+    size_t             prefault_stack; /* Bytes of stack to touch */
+    struct eer_region *regions;        /* Pools to touch */
+    size_t             region_count;
+} eer_loop_attr_t;
+
+/** @brief Steps of eer_realtime_apply(), set in its result when they fail */
+enum eer_realtime_step {
+    EER_REALTIME_AFFINITY = 1 << 0,
+    EER_REALTIME_PRIORITY = 1 << 1,
+    EER_REALTIME_LOCK     = 1 << 2,
+    EER_REALTIME_PREFAULT = 1 << 3
+};
+
+/**
+ * @brief Prepare the calling thread as described by `attr`
+ * @return 0 or the enum eer_realtime_step mask of the steps that failed
+ */
+uint8_t eer_realtime_apply(const eer_loop_attr_t *attr);
+
+/**
+ * @brief Page faults of the calling thread so far, minor and major
+ */
+uint64_t eer_realtime_faults(void);
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "eer.h"
+#include <stddef.h>
+
+/**
+ * @file eer_registry.h
+ * @brief Pooled component registry with a dense stage scan
+ *
+ * A registry keeps pointers to many components together with a dense mirror
+ * of their stage flags, one byte per component. Instead of calling
+ * eer_staging() on every component only to learn that most of them are
+ * RELEASED, the registry
+ * scans the stage bytes (32 at a time with AVX2, 16 with SSE2, 8 with the
+ * portable fallback) and stages only the components that have work pending:
+ * DEFINED, REACTING, PREPARED or UNMOUNTED.
+ *
+ * eer_registry_add() points the component at its stage byte and
+ * eer_staging() refreshes it, so apply, react and shut keep the mirror
+ * current. Only code that writes stage.state.step without staging the
+ * component must call eer_registry_sync().
+ *
+ * Example:
+ * ```c
+ * eer_registry(sensors, 1024);
+ *
+ * eer_registry_add(&sensors, &sensor.instance, &index);
+ * loop() {
+ *   // Releases what the previous iteration prepared, once per pass
+ *   eer_registry_staging(&sensors);
+ *   if (sample_ready())
+ *     apply(Sensor, sensor, _({.value = read_sensor()}));
+ * }
+ * ```
+ *
+ * Staging the registry right after apply() in the same pass would release
+ * the prepared update at once, folding both phases into one iteration.
+ */
+
+/** @brief Scan implementation used by eer_registry_next() */
+enum eer_registry_scan {
+    EER_REGISTRY_SCAN_AUTO,
+    EER_REGISTRY_SCAN_SCALAR,
+    EER_REGISTRY_SCAN_SSE2,
+    EER_REGISTRY_SCAN_AVX2
+};
+
+typedef struct eer_registry {
+    eer_t          **instances;
+    uint8_t         *stages; /* Dense mirror of instances[i]->stage.flags */
+    size_t           size;
+    size_t           used;
+} eer_registry_t;
+
+/**
+ * @brief Defines a registry with static storage for `capacity` components.
+ * @param name The registry name
+ * @param capacity Maximum number of components
+ */
+#define eer_registry(name, capacity)                                           \
+    eer_t          *name##_instances[capacity];                                \
+    uint8_t         name##_stages[capacity] __attribute__((aligned(64)));      \
+    eer_registry_t  name = {.instances = name##_instances,                     \
+                            .stages    = name##_stages,                        \
+                            .size      = capacity,                             \
+                            .used      = 0}
+
+/**
+ * @brief Refresh the mirrored stage of a registered component whose step
+ *        was written directly
+ * @param registry The registry
+ * @param index Index returned by eer_registry_add()
+ */
+static inline void eer_registry_sync(eer_registry_t *registry, size_t index)
+{
+    registry->stages[index] = registry->instances[index]->stage.flags;
+}
+
+/**
+ * @brief Register a component, a component belongs to one registry
+ * @return OK or ERROR_BUFFER_FULL
+ */
+eer_result_t eer_registry_add(eer_registry_t *registry, eer_t *instance,
+                              size_t *index);
+
+/**
+ * @brief Find the next component with pending lifecycle work
+ * @param registry The registry
+ * @param from First index to inspect
+ * @return Index of the next pending component or registry->used
+ */
+size_t eer_registry_next(const eer_registry_t *registry, size_t from);
+
+/**
+ * @brief Stage every pending component of the registry
+ * @return EER_CONTEXT_UPDATED if any component changed, EER_CONTEXT_SAME otherwise
+ */
+enum eer_context eer_registry_staging(eer_registry_t *registry);
+
+/**
+ * @brief Force a scan implementation, EER_REGISTRY_SCAN_AUTO picks the
+ *        widest one supported by the running CPU
+ * @return OK or ERROR_UNKNOWN if the CPU doesn't support it
+ */
+eer_result_t eer_registry_select(enum eer_registry_scan scan);
@@ -0,0 +1,364 @@
+#pragma once
+
+#include "interface.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file eer_ring.h
+ * @brief Header-only lock-free ring buffers
+ *
+ * Two bounded rings of fixed-size items with power-of-two capacity:
+ *
+ * - eer_ring_t: single producer, single consumer. Batch push and pop, and
+ *   zero-copy access with reserve/commit on the producer side and
+ *   peek/consume on the consumer side.
+ * - eer_mpmc_t: many producers, many consumers (Vyukov's bounded queue).
+ *   Every slot carries a sequence number, producers and consumers claim
+ *   positions with a compare-and-swap.
+ *
+ * Producer and consumer indexes sit on separate cache lines so the two
+ * sides do not invalidate each other. Both rings report ERROR_BUFFER_FULL
+ * and ERROR_BUFFER_EMPTY from interface.h.
+ *
+ * Example:
+ * ```c
+ * eer_ring(sample_t, samples, 1024);
+ *
+ * size_t    count = 64;
+ * sample_t *slots = eer_ring_reserve(&samples, &count);
+ * count           = adc_read(slots, count);
+ * eer_ring_commit(&samples, count);
+ * ```
+ */
+
+#define EER_CACHE_LINE 64
+
+#define eer_ring_is_power_of_two(capacity)                                     \
+    ((capacity) && !((capacity) & ((capacity) - 1)))
+
+typedef struct eer_ring {
+    size_t head __attribute__((aligned(EER_CACHE_LINE))); /* Producer */
+    size_t tail __attribute__((aligned(EER_CACHE_LINE))); /* Consumer */
+    uint8_t *buffer __attribute__((aligned(EER_CACHE_LINE)));
+    size_t   item_size;
+    size_t   mask;
+} eer_ring_t;
+
+typedef struct eer_mpmc {
+    size_t head __attribute__((aligned(EER_CACHE_LINE))); /* Next push */
+    size_t tail __attribute__((aligned(EER_CACHE_LINE))); /* Next pop */
+    size_t *sequences __attribute__((aligned(EER_CACHE_LINE)));
+    uint8_t *buffer;
+    size_t   item_size;
+    size_t   mask;
+} eer_mpmc_t;
+
+/**
+ * @brief Defines a SPSC ring with static storage for `capacity` items
+ * @param Type Item type
+ * @param name The ring name
+ * @param capacity Number of items, a power of two
+ */
+#define eer_ring(Type, name, capacity)                                         \
+    _Static_assert(eer_ring_is_power_of_two(capacity),                         \
+                   #name " capacity must be a power of two");                  \
+    Type       name##_items[capacity];                                         \
+    eer_ring_t name = {.buffer    = (uint8_t *)name##_items,                   \
+                       .item_size = sizeof(Type),                              \
+                       .mask      = (capacity) - 1}
+
+/**
+ * @brief Defines a MPMC ring with static storage for `capacity` items
+ *
+ * Sequences are stored relative to the slot index, so zeroed storage is a
+ * valid empty ring.
+ */
+#define eer_mpmc(Type, name, capacity)                                         \
+    _Static_assert(eer_ring_is_power_of_two(capacity),                         \
+                   #name " capacity must be a power of two");                  \
+    Type       name##_items[capacity];                                         \
+    size_t     name##_sequences[capacity];                                     \
+    eer_mpmc_t name = {.sequences = name##_sequences,                          \
+                       .buffer    = (uint8_t *)name##_items,                   \
+                       .item_size = sizeof(Type),                              \
+                       .mask      = (capacity) - 1}
+
+/**
+ * @brief Initialize a SPSC ring over caller-provided storage
+ * @return OK or ERROR_UNKNOWN when capacity is not a power of two
+ */
+static inline eer_result_t eer_ring_init(eer_ring_t *ring, void *buffer,
+                                         size_t item_size, size_t capacity)
+{
+    if (!eer_ring_is_power_of_two(capacity))
+        return ERROR_UNKNOWN;
+
+    ring->head      = 0;
+    ring->tail      = 0;
+    ring->buffer    = buffer;
+    ring->item_size = item_size;
+    ring->mask      = capacity - 1;
+
+    return OK;
+}
+
+/** @brief Number of items waiting in the ring */
+static inline size_t eer_ring_count(eer_ring_t *ring)
+{
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)
+           - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Reserve contiguous free slots for writing in place, producer side
+ * @param ring The ring
+ * @param count Wanted number of slots, set to the number reserved. May be
+ *        less than asked when the free space wraps around the end.
+ * @return First reserved slot or NULL when the ring is full
+ */
+static inline void *eer_ring_reserve(eer_ring_t *ring, size_t *count)
+{
+    size_t head   = ring->head;
+    size_t free   = ring->mask + 1
+                  - (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE));
+    size_t offset = head & ring->mask;
+
+    if (free > ring->mask + 1 - offset)
+        free = ring->mask + 1 - offset;
+    if (*count > free)
+        *count = free;
+
+    return *count ? ring->buffer + offset * ring->item_size : NULL;
+}
+
+/** @brief Publish `count` slots written after eer_ring_reserve() */
+static inline void eer_ring_commit(eer_ring_t *ring, size_t count)
+{
+    __atomic_store_n(&ring->head, ring->head + count, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Contiguous items available for reading in place, consumer side
+ * @param ring The ring
+ * @param count Wanted number of items, set to the number available
+ * @return First item or NULL when the ring is empty
+ */
+static inline void *eer_ring_peek(eer_ring_t *ring, size_t *count)
+{
+    size_t tail      = ring->tail;
+    size_t available = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - tail;
+    size_t offset    = tail & ring->mask;
+
+    if (available > ring->mask + 1 - offset)
+        available = ring->mask + 1 - offset;
+    if (*count > available)
+        *count = available;
+
+    return *count ? ring->buffer + offset * ring->item_size : NULL;
+}
+
+/** @brief Free `count` items read after eer_ring_peek() */
+static inline void eer_ring_consume(eer_ring_t *ring, size_t count)
+{
+    __atomic_store_n(&ring->tail, ring->tail + count, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Copy up to `count` items into the ring, producer side
+ * @return Number of items pushed
+ */
+static inline size_t eer_ring_push_batch(eer_ring_t *ring, const void *items,
+                                         size_t count)
+{
+    const uint8_t *source = items;
+    size_t         pushed = 0;
+
+    // At most two contiguous runs when the free space wraps around
+    for (uint8_t run = 0; run < 2 && pushed < count; run++) {
+        size_t length = count - pushed;
+        void  *slots  = eer_ring_reserve(ring, &length);
+
+        if (!slots)
+            break;
+        memcpy(slots, source + pushed * ring->item_size,
+               length * ring->item_size);
+        eer_ring_commit(ring, length);
+        pushed += length;
+    }
+
+    return pushed;
+}
+
+/**
+ * @brief Copy up to `count` items out of the ring, consumer side
+ * @return Number of items popped
+ */
+static inline size_t eer_ring_pop_batch(eer_ring_t *ring, void *items,
+                                        size_t count)
+{
+    uint8_t *target = items;
+    size_t   popped = 0;
+
+    for (uint8_t run = 0; run < 2 && popped < count; run++) {
+        size_t length = count - popped;
+        void  *slots  = eer_ring_peek(ring, &length);
+
+        if (!slots)
+            break;
+        memcpy(target + popped * ring->item_size, slots,
+               length * ring->item_size);
+        eer_ring_consume(ring, length);
+        popped += length;
+    }
+
+    return popped;
+}
+
+/** @return OK or ERROR_BUFFER_FULL */
+static inline eer_result_t eer_ring_push(eer_ring_t *ring, const void *item)
+{
+    return eer_ring_push_batch(ring, item, 1) ? OK : ERROR_BUFFER_FULL;
+}
+
+/** @return OK or ERROR_BUFFER_EMPTY */
+static inline eer_result_t eer_ring_pop(eer_ring_t *ring, void *item)
+{
+    return eer_ring_pop_batch(ring, item, 1) ? OK : ERROR_BUFFER_EMPTY;
+}
+
+/**
+ * @brief Initialize a MPMC ring over caller-provided storage
+ * @param sequences Array of `capacity` sequence numbers
+ * @return OK or ERROR_UNKNOWN when capacity is not a power of two
+ */
+static inline eer_result_t eer_mpmc_init(eer_mpmc_t *ring, void *buffer,
+                                         size_t *sequences, size_t item_size,
+                                         size_t capacity)
+{
+    if (!eer_ring_is_power_of_two(capacity))
+        return ERROR_UNKNOWN;
+
+    memset(sequences, 0, capacity * sizeof(*sequences));
+    ring->head      = 0;
+    ring->tail      = 0;
+    ring->sequences = sequences;
+    ring->buffer    = buffer;
+    ring->item_size = item_size;
+    ring->mask      = capacity - 1;
+
+    return OK;
+}
+
+/** @return OK or ERROR_BUFFER_FULL */
+static inline eer_result_t eer_mpmc_push(eer_mpmc_t *ring, const void *item)
+{
+    size_t position = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    size_t index;
+
+    for (;;) {
+        index = position & ring->mask;
+
+        size_t sequence
+            = __atomic_load_n(&ring->sequences[index], __ATOMIC_ACQUIRE)
+              + index;
+        intptr_t difference = (intptr_t)(sequence - position);
+
+        if (!difference) {
+            if (__atomic_compare_exchange_n(&ring->head, &position,
+                                            position + 1, true,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+                break;
+        } else if (difference < 0) {
+            return ERROR_BUFFER_FULL;
+        } else {
+            position = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy(ring->buffer + index * ring->item_size, item, ring->item_size);
+    __atomic_store_n(&ring->sequences[index], position + 1 - index,
+                     __ATOMIC_RELEASE);
+
+    return OK;
+}
+
+/** @return OK or ERROR_BUFFER_EMPTY */
+static inline eer_result_t eer_mpmc_pop(eer_mpmc_t *ring, void *item)
+{
+    size_t position = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    size_t index;
+
+    for (;;) {
+        index = position & ring->mask;
+
+        size_t sequence
+            = __atomic_load_n(&ring->sequences[index], __ATOMIC_ACQUIRE)
+              + index;
+        intptr_t difference = (intptr_t)(sequence - (position + 1));
+
+        if (!difference) {
+            if (__atomic_compare_exchange_n(&ring->tail, &position,
+                                            position + 1, true,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+                break;
+        } else if (difference < 0) {
+            return ERROR_BUFFER_EMPTY;
+        } else {
+            position = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    memcpy(item, ring->buffer + index * ring->item_size, ring->item_size);
+    __atomic_store_n(&ring->sequences[index], position + ring->mask + 1 - index,
+                     __ATOMIC_RELEASE);
+
+    return OK;
+}
+
+/**
+ * @brief Push up to `count` items, stopping at the first full slot
+ * @return Number of items pushed
+ */
+static inline size_t eer_mpmc_push_batch(eer_mpmc_t *ring, const void *items,
+                                         size_t count)
+{
+    const uint8_t *source = items;
+    size_t         pushed = 0;
+
+    while (pushed < count
+           && eer_mpmc_push(ring, source + pushed * ring->item_size) == OK)
+        pushed++;
+
+    return pushed;
+}
+
+/**
+ * @brief Pop up to `count` items, stopping at the first empty slot
+ * @return Number of items popped
+ */
+static inline size_t eer_mpmc_pop_batch(eer_mpmc_t *ring, void *items,
+                                        size_t count)
+{
+    uint8_t *target = items;
+    size_t   popped = 0;
+
+    while (popped < count
+           && eer_mpmc_pop(ring, target + popped * ring->item_size) == OK)
+        popped++;
+
+    return popped;
+}
+
+/** @brief Approximate number of items, exact when no push or pop runs */
+static inline size_t eer_mpmc_count(eer_mpmc_t *ring)
+{
+    size_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    size_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    return head > tail ? head - tail : 0;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "interface.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file eer_screen.h
+ * @brief Double-buffered terminal screen with diff rendering
+ *
+ * Printing escape sequences from every component costs a syscall per
+ * fflush() and redraws cells that did not change. Components draw into the
+ * back buffer of an eer_screen_t instead, usually in did_mount and
+ * did_update. Once per iteration eer_screen_render() compares it with the
+ * front buffer, the cells the terminal shows, and emits only the cursor
+ * moves, colors and glyphs of changed cells in a single write().
+ *
+ * ```c
+ * eer_screen_t screen;
+ *
+ * DID_UPDATE(Clock) {
+ *     eer_screen_color(&screen, EER_SCREEN_CYAN, EER_SCREEN_BLACK);
+ *     eer_screen_print(&screen, 0, screen.cols - 10, "%s", state->time);
+ * }
+ *
+ * eer_screen_init(&screen, STDOUT_FILENO);
+ * loop_on(&main_loop, clock) {
+ *     eer_screen_render(&screen);
+ * }
+ * eer_screen_release(&screen);
+ * ```
+ *
+ * The terminal size is read once and again after SIGWINCH, the buffers keep
+ * their content clipped to the new size and the next render redraws all.
+ * Rows and columns are counted from 0.
+ *
+ * eer_screen_headless() renders without a terminal for benchmarks and
+ * tests: EER_SCREEN_MEMORY keeps each frame in `output` without writing it,
+ * EER_SCREEN_NULL writes it to /dev/null to include the syscall cost.
+ */
+
+/** @brief SGR color codes, foreground. Add 10 for the background. */
+enum eer_screen_color {
+    EER_SCREEN_DEFAULT = 0,
+    EER_SCREEN_BLACK   = 30,
+    EER_SCREEN_RED,
+    EER_SCREEN_GREEN,
+    EER_SCREEN_YELLOW,
+    EER_SCREEN_BLUE,
+    EER_SCREEN_MAGENTA,
+    EER_SCREEN_CYAN,
+    EER_SCREEN_WHITE
+};
+
+/** @brief Where rendered frames go */
+enum eer_screen_target {
+    EER_SCREEN_TERMINAL, /* The descriptor passed to eer_screen_init() */
+    EER_SCREEN_MEMORY,   /* Kept in `output`, `length` bytes */
+    EER_SCREEN_NULL      /* Written to /dev/null */
+};
+
+struct eer_cell {
+    uint8_t glyph;
+    uint8_t fg; /* enum eer_screen_color */
+    uint8_t bg; /* enum eer_screen_color, foreground code */
+};
+
+typedef struct eer_screen {
+    uint16_t         rows;
+    uint16_t         cols;
+    struct eer_cell *front; /* Cells shown by the terminal */
+    struct eer_cell *back;  /* Cells of the frame being drawn */
+    uint8_t          fg, bg; /* Pen used by the drawing functions */
+    enum eer_screen_target target;
+    int                    fd;
+    bool                   invalid; /* Next render redraws every cell */
+
+    char  *output; /* Escape sequences of one frame */
+    size_t output_capacity;
+    size_t length; /* Bytes of the last frame in `output` */
+
+    uint64_t frames; /* Renders that wrote something */
+    uint64_t bytes;  /* Bytes written */
+} eer_screen_t;
+
+/**
+ * @brief Size the screen to the terminal behind `fd` and watch SIGWINCH
+ * @return OK or ERROR_UNKNOWN when the buffers cannot be allocated
+ */
+eer_result_t eer_screen_init(eer_screen_t *screen, int fd);
+
+/**
+ * @brief Size the screen to `rows` x `cols` without a terminal
+ * @param target EER_SCREEN_MEMORY or EER_SCREEN_NULL
+ * @return OK or ERROR_UNKNOWN when the target cannot be opened
+ */
+eer_result_t eer_screen_headless(eer_screen_t *screen,
+                                 enum eer_screen_target target, uint16_t rows,
+                                 uint16_t cols);
+
+/**
+ * @brief Free the buffers, closes /dev/null for EER_SCREEN_NULL
+ */
+void eer_screen_release(eer_screen_t *screen);
+
+/**
+ * @brief Set the pen for the next drawing calls
+ */
+void eer_screen_color(eer_screen_t *screen, enum eer_screen_color fg,
+                      enum eer_screen_color bg);
+
+/**
+ * @brief Fill the back buffer with blanks in the default colors
+ */
+void eer_screen_clear(eer_screen_t *screen);
+
+/**
+ * @brief Draw formatted text at `row`, `col`, clipped at the right edge
+ * @return Number of cells drawn
+ */
+size_t eer_screen_print(eer_screen_t *screen, int row, int col,
+                        const char *format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+/**
+ * @brief Draw `count` copies of `glyph` at `row`, `col`
+ */
+void eer_screen_fill(eer_screen_t *screen, int row, int col, int count,
+                     char glyph);
+
+/**
+ * @brief Write the difference between the back and front buffers
+ * @return Bytes of the frame, 0 when nothing changed
+ */
+size_t eer_screen_render(eer_screen_t *screen);
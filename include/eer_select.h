@@ -0,0 +1,110 @@
+#pragma once
+
+#include "eer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file eer_select.h
+ * @brief Memoized selectors over component state
+ *
+ * Components that derive the same value from shared state, a formatted time
+ * or a sum over several sensors, compute it again in every release. A
+ * selector is a pure function over declared inputs, state fields of
+ * components, with a cached result. Each input keeps the version of its
+ * component and a copy of the field at the last computation. eer_select()
+ * skips the inputs whose component was not released since with one integer
+ * compare, and recomputes only when a released component changed the field,
+ * so many consumers share one computation per change.
+ *
+ * ```c
+ * void total_power(void *context, void *value)
+ * {
+ *     *(int *)value = left.state.watts + right.state.watts;
+ * }
+ *
+ * eer_selector(int, power, total_power, NULL,
+ *              eer_select_input(left, state.watts),
+ *              eer_select_input(right, state.watts));
+ *
+ * RELEASE(Gauge) {
+ *     state->level = eer_select(int, power) * 100 / props->max_watts;
+ * }
+ * ```
+ *
+ * The compute function must read only the declared fields and `context`. Selectors are not synchronized and belong to one loop thread.
+ */
+
+/** @brief Field a selector depends on, see eer_select_input() */
+struct eer_select_input {
+    const eer_t *instance;
+    const void  *field;
+    size_t       size;
+    uint8_t     *bytes; /* Bytes of the field at the last computation */
+    uint32_t     seen;  /* Version at the last computation */
+};
+
+/**
+ * @brief Compute the selected value into `value`
+ */
+typedef void (*eer_select_compute_t)(void *context, void *value);
+
+typedef struct eer_selector {
+    eer_select_compute_t     compute;
+    void                    *context;
+    struct eer_select_input *inputs;
+    size_t                   count;
+    void                    *value;
+    bool                     valid;
+
+    uint64_t computes; /* Calls of `compute` */
+    uint64_t hits;     /* Reads served from the cache */
+} eer_selector_t;
+
+/**
+ * @brief Declare a field of a component as a selector input
+ * @param name The component instance
+ * @param member The field, as in `state.watts`
+ */
+#define eer_select_input(name, member)                                         \
+    {                                                                          \
+        .instance = &(name).instance, .field = &(name).member,                 \
+        .size = sizeof((name).member),                                         \
+        .bytes = (uint8_t[sizeof((name).member)]){0}                           \
+    }
+
+/**
+ * @brief Defines a selector `name` of type `Type` with static storage
+ * @param Type Type of the selected value
+ * @param name The selector name
+ * @param compute eer_select_compute_t computing the value
+ * @param context Passed to `compute`
+ * @param ... eer_select_input() of every field `compute` reads
+ */
+#define eer_selector(Type, name, compute_value, compute_context, ...)          \
+    Type                    name##_value;                                      \
+    struct eer_select_input name##_inputs[] = {__VA_ARGS__};                   \
+    eer_selector_t          name = {                                           \
+        .compute = compute_value,                                              \
+        .context = compute_context,                                            \
+        .inputs  = name##_inputs,                                              \
+        .count   = sizeof(name##_inputs) / sizeof(*name##_inputs),             \
+        .value   = &name##_value}
+
+/**
+ * @brief Read the value of a selector, computed again if an input changed
+ * @param Type Type of the selected value
+ * @param name The selector
+ */
+#define eer_select(Type, name) (*(const Type *)eer_selector_get(&(name)))
+
+/**
+ * @brief Value of `selector`, computed again if an input changed
+ */
+const void *eer_selector_get(eer_selector_t *selector);
+
+/**
+ * @brief Drop the cached value, the next read computes it
+ */
+void eer_selector_invalidate(eer_selector_t *selector);
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "eer_hal.h"
+
+/**
+ * @file eer_sim.h
+ * @brief Controls of the simulation HAL
+ *
+ * The simulation keeps a virtual monotonic clock. In EER_SIM_REALTIME mode
+ * it follows CLOCK_MONOTONIC and hw(timer).sleep_until() really sleeps. In
+ * EER_SIM_FAST mode time only moves when the program waits: sleep_until()
+ * jumps straight to the deadline, firing the timers due on the way at their
+ * own deadlines. An hours-long scenario then runs as fast as its code does,
+ * with the same timestamps on every run. sleep_until(UINT64_MAX) only runs
+ * up to the last one-shot timer, periodic timers alone would never end it.
+ *
+ * ```c
+ * eer_sim_clock(EER_SIM_FAST);
+ * hw(timer).start(&tick, 0, 1000000, (eer_callback_t){sample, &sensor});
+ *
+ * loop() {
+ *     react(Sensor, sensor, _({.value = eer_sim_gpio_level(&probe)}));
+ *     hw(timer).sleep_until(hw(timer).next_deadline());
+ *     exit_when(eer_now_us() >= 3600ull * 1000000);
+ * }
+ * ```
+ *
+ * The simulation is meant for one loop thread, the peripherals are not
+ * synchronized.
+ */
+
+enum eer_sim_clock_mode { EER_SIM_REALTIME, EER_SIM_FAST };
+
+/** @brief Switch the clock mode, virtual time continues from its value */
+void eer_sim_clock(enum eer_sim_clock_mode mode);
+
+/** @brief Move virtual time forward without firing timers */
+void eer_sim_advance(uint64_t delay);
+
+/** @brief Drive the level of an input pin as the outside world */
+void eer_sim_gpio_drive(eer_pin_t *pin, bool level);
+
+/** @brief Current level of a pin */
+bool eer_sim_gpio_level(eer_pin_t *pin);
+
+/**
+ * @brief Queue bytes on the simulated UART line for hw(uart).read()
+ * @return Number of bytes queued
+ */
+size_t eer_sim_uart_receive(const uint8_t *data, size_t size);
+
+/**
+ * @brief Take bytes written with hw(uart).write()
+ * @return Number of bytes taken
+ */
+size_t eer_sim_uart_transmitted(uint8_t *data, size_t size);
+
+/**
+ * @brief Cost model of the simulated flash
+ *
+ * Every program costs `program_us` plus `program_byte_ns` per byte, every
+ * erase `erase_us`. The time is only accounted in eer_sim_flash_stats_t:
+ * the simulated flash does not block.
+ */
+typedef struct eer_sim_flash_timing {
+    uint32_t program_us;
+    uint32_t program_byte_ns;
+    uint32_t erase_us;
+} eer_sim_flash_timing_t;
+
+/** @brief Typical serial NOR flash, used until eer_sim_flash_timing() */
+#define EER_SIM_FLASH_TIMING                                                   \
+    ((eer_sim_flash_timing_t){                                                 \
+        .program_us = 10, .program_byte_ns = 40, .erase_us = 40000})
+
+typedef struct eer_sim_flash_stats {
+    uint64_t reads;
+    uint64_t read_bytes;
+    uint64_t programs;
+    uint64_t program_bytes;
+    uint64_t erases;
+    uint64_t faults;    /* Programs rejected for bits that were not erased */
+    uint64_t busy_ns;   /* Time spent programming and erasing */
+    uint32_t erase_min; /* Fewest erases of a sector */
+    uint32_t erase_max; /* Most erases of a sector */
+} eer_sim_flash_stats_t;
+
+/**
+ * @brief Back hw(flash) with the file at `path`
+ *
+ * A file of another size is erased to `sectors` sectors of `sector_size`
+ * bytes, an existing one keeps its contents like flash keeps them over a
+ * power cycle. Erase counts start at zero on every open.
+ *
+ * @return OK or ERROR_UNKNOWN when the file cannot be opened
+ */
+eer_result_t eer_sim_flash_open(const char *path, uint32_t sector_size,
+                                uint16_t sectors);
+
+/** @brief Detach hw(flash) from its file */
+void eer_sim_flash_close(void);
+
+/** @brief Replace the cost model */
+void eer_sim_flash_timing(eer_sim_flash_timing_t timing);
+
+/** @brief Counters since the flash was opened */
+void eer_sim_flash_stats(eer_sim_flash_stats_t *stats);
+
+/**
+ * @brief Cut the power after `bytes` more programmed bytes
+ *
+ * The program crossing the limit writes only its first bytes and every
+ * later program or erase fails, until the flash is opened again.
+ */
+void eer_sim_flash_cut(uint64_t bytes);
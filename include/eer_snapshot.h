@@ -0,0 +1,93 @@
+#pragma once
+
+#include "eer.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file eer_snapshot.h
+ * @brief Snapshot of component props and state for warm starts
+ *
+ * Components that build large tables in will_mount pay for it on every
+ * start. A snapshot lists components, saves their props, state and version
+ * into a memory-mapped file, and on the next start restores them from the
+ * mapping straight into the RELEASED stage: no mount hook runs.
+ *
+ * ```c
+ * eer_snapshot(warm, 16, 1);
+ *
+ * eer_snapshot_add(&warm, Router, router);
+ * eer_snapshot_add(&warm, Cache, cache);
+ * if (OK != eer_snapshot_restore(&warm, "/var/lib/app/warm.eer"))
+ *     log_info("cold start");
+ * loop_on(&main_loop, router, cache) { ... }
+ * eer_snapshot_save(&warm, "/var/lib/app/warm.eer");
+ * ```
+ *
+ * The file starts with a header holding the format and the application's
+ * `schema` version, followed by one entry per component with a hash of its
+ * name and its size. A restore checks all of them before touching any
+ * component, so a file written by another build or schema leaves every
+ * component DEFINED for a normal mount. Saving writes a temporary file and
+ * renames it over the old one, a crash never leaves a torn snapshot.
+ *
+ * Props and state are copied as bytes: only snapshot components whose props
+ * and state hold no pointers, descriptors or other process-bound handles.
+ */
+
+#define EER_SNAPSHOT_MAGIC  0x53524545u /* "EERS" */
+#define EER_SNAPSHOT_FORMAT 1
+
+/** @brief Component listed in a snapshot */
+struct eer_snapshot_entry {
+    eer_t      *instance;
+    void       *data; /* Props followed by state */
+    size_t      size;
+    uint64_t    name; /* Hash of the instance name */
+};
+
+typedef struct eer_snapshot {
+    struct eer_snapshot_entry *entries;
+    size_t                     count;
+    size_t                     capacity;
+    uint32_t                   schema; /* Bumped by the application when
+                                          props or state change layout */
+} eer_snapshot_t;
+
+/**
+ * @brief Defines a snapshot with static storage for `capacity` components
+ * @param name The snapshot name
+ * @param capacity Maximum number of components
+ * @param schema Application schema version stored in the file
+ */
+#define eer_snapshot(name, capacity_size, schema_version)                      \
+    struct eer_snapshot_entry name##_entries[capacity_size];                   \
+    eer_snapshot_t            name = {.entries  = name##_entries,              \
+                                      .capacity = capacity_size,               \
+                                      .schema   = schema_version}
+
+/**
+ * @brief List component `name` of type `Type` in a snapshot
+ * @return OK or ERROR_BUFFER_FULL
+ */
+#define eer_snapshot_add(snapshot, Type, name)                                 \
+    eer_snapshot_register(snapshot, &(name).instance, &(name).props,          \
+                          sizeof(Type##_t) - offsetof(Type##_t, props), #name)
+
+eer_result_t eer_snapshot_register(eer_snapshot_t *snapshot, eer_t *instance,
+                                   void *data, size_t size, const char *name);
+
+/**
+ * @brief Write props, state and versions of the listed components to `path`
+ * @return OK or ERROR_UNKNOWN when the file cannot be written
+ */
+eer_result_t eer_snapshot_save(eer_snapshot_t *snapshot, const char *path);
+
+/**
+ * @brief Map `path` and restore the listed components into RELEASED
+ *        without running mount hooks
+ * @return OK, or ERROR_UNKNOWN when the file is missing or does not match
+ *         the listed components, which are then left untouched
+ */
+eer_result_t eer_snapshot_restore(eer_snapshot_t *snapshot, const char *path);
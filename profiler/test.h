@@ -96,6 +96,7 @@
     int program_thread_id;                                                     \
     int r;                                                                     \
     before;                                                                    \
+    log_init();                                                                \
     eer_hooks_init();                                                          \
     pthread_create(&program_thread, NULL, __program,                           \
                    (void *)&program_thread_id);                                \
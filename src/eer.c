@@ -1,83 +1,297 @@
 #include <eer.h>
+#include <string.h>
+
+/* Transition table rows */
+#define eer_idle(stage, context)       {0, stage, context}
+#define eer_mount                                                              \
+    {EER_ACTION_WILL_MOUNT | EER_ACTION_RELEASE | EER_ACTION_DID_MOUNT,        \
+     EER_STAGE_RELEASED, EER_CONTEXT_UPDATED}
+#define eer_prepare                                                            \
+    {EER_ACTION_SHOULD_UPDATE | EER_ACTION_WILL_UPDATE, EER_STAGE_PREPARED,    \
+     EER_CONTEXT_UPDATED}
+#define eer_react_all                                                          \
+    {EER_ACTION_WILL_UPDATE | EER_ACTION_RELEASE | EER_ACTION_DID_UPDATE,      \
+     EER_STAGE_RELEASED, EER_CONTEXT_UPDATED}
+#define eer_commit                                                             \
+    {EER_ACTION_RELEASE | EER_ACTION_DID_UPDATE, EER_STAGE_RELEASED,           \
+     EER_CONTEXT_UPDATED}
+#define eer_unmount                                                            \
+    {EER_ACTION_DID_UNMOUNT, EER_STAGE_BLOCKED, EER_CONTEXT_UPDATED}
 
 /**
- * @brief Core function that manages component lifecycle transitions
- * 
- * This function is the heart of the EER framework's reactivity system.
- * It handles all transitions between component lifecycle states:
+ * @brief Lifecycle transitions indexed by [stage][context]
+ *
  * - DEFINED -> RELEASED (mounting)
  * - RELEASED -> PREPARED -> RELEASED (updating via apply)
- * - REACTING -> PREPARED -> RELEASED (forced update via react)
- * - UNMOUNTED -> BLOCKED (unmounting)
- * 
+ * - REACTING -> RELEASED (forced update via react)
+ * - any -> UNMOUNTED -> BLOCKED (unmounting)
+ *
+ * EER_CONTEXT_SAME leaves mounted components alone, EER_CONTEXT_BLOCKED
+ * unmounts and a pointer to next props behaves like EER_CONTEXT_UPDATED.
+ * BLOCKED components stay idle but report EER_CONTEXT_UPDATED to any other
+ * context than EER_CONTEXT_SAME: loops OR the results of their components,
+ * and a shut sibling must not turn the context of the loop into BLOCKED.
+ * New stages are added as rows, unused step values stay idle.
+ */
+const struct eer_transition eer_transitions[EER_STAGES]
+                                           [EER_TRANSITION_CONTEXTS] = {
+    [EER_STAGE_BLOCKED] = {eer_idle(EER_STAGE_BLOCKED, EER_CONTEXT_SAME),
+                           eer_idle(EER_STAGE_BLOCKED, EER_CONTEXT_UPDATED),
+                           eer_idle(EER_STAGE_BLOCKED, EER_CONTEXT_UPDATED),
+                           eer_idle(EER_STAGE_BLOCKED, EER_CONTEXT_UPDATED)},
+    [EER_STAGE_RELEASED] = {eer_idle(EER_STAGE_RELEASED, EER_CONTEXT_SAME),
+                            eer_prepare, eer_unmount, eer_prepare},
+    [EER_STAGE_DEFINED] = {eer_mount, eer_mount, eer_unmount, eer_mount},
+    [EER_STAGE_REACTING] = {eer_react_all, eer_react_all, eer_unmount,
+                            eer_react_all},
+    [EER_STAGE_PREPARED] = {eer_commit, eer_commit, eer_unmount, eer_commit},
+    [EER_STAGE_UNMOUNTED] = {eer_unmount, eer_unmount, eer_unmount,
+                             eer_unmount},
+    [6] = {eer_idle(6, EER_CONTEXT_SAME), eer_idle(6, EER_CONTEXT_SAME),
+           eer_idle(6, EER_CONTEXT_SAME), eer_idle(6, EER_CONTEXT_SAME)},
+    [7] = {eer_idle(7, EER_CONTEXT_SAME), eer_idle(7, EER_CONTEXT_SAME),
+           eer_idle(7, EER_CONTEXT_SAME), eer_idle(7, EER_CONTEXT_SAME)},
+};
+
+/**
+ * @brief Core function that manages component lifecycle transitions
+ *
+ * This function is the heart of the EER framework's reactivity system.
+ * It looks up the (stage, context) entry of eer_transitions and runs the
+ * hooks of its action mask in a fixed order:
+ * should_update, will_mount, will_update, release, did_mount, did_update,
+ * did_unmount.
+ *
  * The key difference between apply() and react():
  * - apply(): Calls eer_staging once, moving component to PREPARED state.
  *            A second iteration is needed to complete the update.
  * - react(): Sets state to REACTING, then calls eer_staging which completes
  *            the entire update cycle in a single iteration.
- * 
+ *
  * @param instance Pointer to the component instance
  * @param next_props Either new props or a context flag
  * @return enum eer_context The new context state
  */
-enum eer_context eer_staging(eer_t *instance, void *next_props)
+static enum eer_context eer_staging_hooks(eer_t *instance, void *next_props)
 {
     // Determine if next_props is actually a context flag
     uintptr_t context = (uintptr_t)next_props;
 
-    // Handle different context flags
-    if(EER_CONTEXT_SAME == context) {
-        // No change needed if component is already mounted
-        if(EER_STAGE_RELEASED >= instance->stage.state.step)
-            return EER_CONTEXT_SAME;
-    } else if(EER_CONTEXT_UPDATED == context) {
-        // Context update without props change
+    if (context > EER_CONTEXT_BLOCKED)
+        context = EER_TRANSITION_PROPS;
+    else
         next_props = 0;
-    } else if (EER_CONTEXT_BLOCKED == context) {
-        // Block the component (prepare for unmounting)
-        instance->stage.state.step = EER_STAGE_UNMOUNTED;
-    }
 
-    // Handle component lifecycle transitions based on current stage
-    if (EER_STAGE_RELEASED == instance->stage.state.step) {
-        /* Normal update path: Check if component should update */
-        if(!instance->should_update(instance, next_props)) {
-            return EER_CONTEXT_SAME; // Skip update if should_update returns false
-        }
+    const struct eer_transition *transition
+        = &eer_transitions[instance->stage.state.step][context];
+    uint8_t actions = transition->actions;
 
-        // Prepare for update
-        instance->stage.state.step = EER_STAGE_PREPARED;
-        instance->will_update(instance, next_props);
-    } else if (EER_STAGE_REACTING == instance->stage.state.step) {
-        // Forced update path (react)
-        instance->stage.state.step = EER_STAGE_PREPARED;
-        instance->will_update(instance, next_props);
-        instance->stage.state.step = EER_STAGE_RELEASED;
-        instance->release(instance);
-        instance->did_update(instance);
-    } else if (EER_STAGE_PREPARED == instance->stage.state.step) {
-        // Complete the update process
-        instance->stage.state.step = EER_STAGE_RELEASED;
-        instance->release(instance);
-        instance->did_update(instance);
-    } else if (EER_STAGE_DEFINED == instance->stage.state.step) {
-        // Initial mounting process
+    if (!actions)
+        return (enum eer_context)transition->context;
+
+    /* Normal update path: Check if component should update */
+    if ((actions & EER_ACTION_SHOULD_UPDATE)
+        && !instance->should_update(instance, next_props))
+        return EER_CONTEXT_SAME;
+
+    if (actions & EER_ACTION_WILL_MOUNT) {
 #ifdef PROFILING
-        hash_write(&eer_scope, eer_hash_component(instance->name), (void **)instance);
+        hash_write(&eer_scope, eer_hash_component(instance->name),
+                   (void **)instance);
 #endif
-        // Execute mounting lifecycle
         instance->will_mount(instance, next_props);
+    }
+
+    // Fused components run will_update, release and did_update as one call
+    if (instance->update && (actions & EER_ACTION_RELEASE)
+        && !(actions & EER_ACTION_WILL_MOUNT)) {
+        instance->stage.state.step = transition->next;
+        instance->version += 1;
+        instance->update(instance, (actions & EER_ACTION_WILL_UPDATE)
+                                       ? next_props
+                                       : 0);
+
+        return (enum eer_context)transition->context;
+    }
+
+    if (actions & EER_ACTION_WILL_UPDATE) {
+        instance->stage.state.step = EER_STAGE_PREPARED;
+        instance->will_update(instance, next_props);
+    }
+
+    // Mounting components stay DEFINED until did_mount has run
+    if (!(actions & EER_ACTION_WILL_MOUNT))
+        instance->stage.state.step = transition->next;
+
+    if (actions & EER_ACTION_RELEASE) {
+        instance->version += 1;
         instance->release(instance);
+    }
+    if (actions & EER_ACTION_DID_MOUNT)
         instance->did_mount(instance);
-        instance->stage.state.step = EER_STAGE_RELEASED;
-    } else if (EER_STAGE_UNMOUNTED == instance->stage.state.step) {
-        // Unmounting process
-        instance->stage.state.step = EER_STAGE_BLOCKED;
+    if (actions & EER_ACTION_DID_UPDATE)
+        instance->did_update(instance);
+    if (actions & EER_ACTION_DID_UNMOUNT)
         instance->did_unmount(instance);
-    } else if (EER_STAGE_BLOCKED) {
-        // Component is blocked, cannot process further
-        return EER_CONTEXT_BLOCKED;
+
+    // Other rows set the stage before their hooks, which may change it again
+    if (actions & EER_ACTION_WILL_MOUNT)
+        instance->stage.state.step = transition->next;
+
+    return (enum eer_context)transition->context;
+}
+
+/* Components left PREPARED on this thread, see eer_staging_pending() */
+static __thread bool eer_staging_prepared;
+
+/*
+ * Copy the stage into the registry mirror of the component, if any, and
+ * note components that wait for another stage to release
+ */
+static inline void eer_staging_mirror(eer_t *instance)
+{
+    if (instance->mirror)
+        *instance->mirror = instance->stage.flags;
+    if (EER_STAGE_PREPARED == instance->stage.state.step)
+        eer_staging_prepared = true;
+}
+
+void eer_staging_restore(eer_t *instance)
+{
+    instance->stage.state.step = EER_STAGE_RELEASED;
+    eer_staging_mirror(instance);
+}
+
+bool eer_staging_pending(void)
+{
+    bool pending = eer_staging_prepared;
+
+    eer_staging_prepared = false;
+
+    return pending;
+}
+
+enum eer_context eer_staging(eer_t *instance, void *next_props)
+{
+    enum eer_context context = eer_staging_hooks(instance, next_props);
+
+    eer_staging_mirror(instance);
+
+    return context;
+}
+
+bool eer_staging_update(eer_t *instance, const void *props, void *next_props,
+                        size_t size)
+{
+    if (!memcmp(props, next_props, size)
+        || !instance->should_update(instance, next_props))
+        return false;
+
+    instance->stage.state.step = EER_STAGE_REACTING;
+    eer_staging(instance, next_props);
+
+    return true;
+}
+
+void eer_staging_unmount(eer_t *instance, const eer_t *prototype)
+{
+    uint32_t version;
+
+    instance->stage.state.step = EER_STAGE_UNMOUNTED;
+    eer_staging(instance, 0);
+
+    // Freed slots keep counting versions for consumers of the old child
+    version           = instance->version;
+    *instance         = *prototype;
+    instance->version = version;
+}
+
+/* Scratch steps of eer_staging_batch entries */
+enum { EER_BATCH_DONE, EER_BATCH_COMMIT, EER_BATCH_CHECK, EER_BATCH_ACCEPTED };
+
+/**
+ * @brief Stage a batch of components one lifecycle hook at a time
+ *
+ * Entries PREPARED by the previous call are released, then did_update runs
+ * over all of them. With EER_CONTEXT_UPDATED, DEFINED entries mount with
+ * their props, should_update runs over the RELEASED entries and will_update
+ * over the accepted ones, leaving the whole group PREPARED together.
+ * Entries in any other stage are staged individually like apply() does.
+ *
+ * @param batch Entries to stage
+ * @param count Number of entries
+ * @param context Context of the current iteration
+ * @return enum eer_context EER_CONTEXT_UPDATED if any entry changed
+ */
+enum eer_context eer_staging_batch(struct eer_batch *batch, size_t count,
+                                   enum eer_context context)
+{
+    enum eer_context result = EER_CONTEXT_SAME;
+    bool             commits = false, checks = false;
+
+    for (size_t index = 0; index < count; index++) {
+        eer_t *instance = batch[index].instance;
+        bool   apply = EER_CONTEXT_UPDATED == context;
+
+        batch[index].step = EER_BATCH_DONE;
+        if (EER_STAGE_PREPARED == instance->stage.state.step) {
+            batch[index].step = EER_BATCH_COMMIT;
+            commits           = true;
+        } else if (apply && EER_STAGE_RELEASED == instance->stage.state.step) {
+            batch[index].step = EER_BATCH_CHECK;
+            checks            = true;
+        } else {
+            result |= eer_staging(instance, (apply && EER_STAGE_DEFINED
+                                                == instance->stage.state.step)
+                                                ? batch[index].next_props
+                                                : 0);
+        }
+    }
+
+    if (commits) {
+        for (size_t index = 0; index < count; index++) {
+            eer_t *instance = batch[index].instance;
+
+            if (EER_BATCH_COMMIT != batch[index].step)
+                continue;
+            instance->stage.state.step = EER_STAGE_RELEASED;
+            eer_staging_mirror(instance);
+            instance->version += 1;
+            if (instance->update)
+                instance->update(instance, 0);
+            else
+                instance->release(instance);
+        }
+        for (size_t index = 0; index < count; index++) {
+            eer_t *instance = batch[index].instance;
+
+            if (EER_BATCH_COMMIT == batch[index].step && !instance->update)
+                instance->did_update(instance);
+        }
+        result |= EER_CONTEXT_UPDATED;
+    }
+
+    if (!checks)
+        return result;
+
+    for (size_t index = 0; index < count; index++) {
+        eer_t *instance = batch[index].instance;
+
+        if (EER_BATCH_CHECK == batch[index].step
+            && instance->should_update(instance, batch[index].next_props))
+            batch[index].step = EER_BATCH_ACCEPTED;
+    }
+
+    for (size_t index = 0; index < count; index++) {
+        eer_t *instance = batch[index].instance;
+
+        if (EER_BATCH_ACCEPTED != batch[index].step)
+            continue;
+        instance->stage.state.step = EER_STAGE_PREPARED;
+        eer_staging_mirror(instance);
+        instance->will_update(instance, batch[index].next_props);
+        result |= EER_CONTEXT_UPDATED;
     }
 
-    return EER_CONTEXT_UPDATED;
+    return result;
 }
@@ -0,0 +1,99 @@
+#include <eer_fd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/* Watches a paused input again once the consumer made room in the ring */
+static eer_result_t eer_fd_resume(void *argument, void *trigger)
+{
+    FdInput_t *input = argument;
+    eer_ring_t *ring = input->props.buffer;
+
+    if (!input->state.paused || eer_ring_count(ring) > ring->mask)
+        return OK;
+
+    input->state.paused  = false;
+    input->state.watched = eer_loop_watch(trigger, &input->state.watch) == OK;
+
+    return OK;
+}
+
+WILL_MOUNT(FdInput)
+{
+    int flags = fcntl(props->fd, F_GETFL);
+
+    if (flags >= 0)
+        fcntl(props->fd, F_SETFL, flags | O_NONBLOCK);
+
+    state->watch.fd    = props->fd;
+    state->watch.ready = false;
+    state->watched     = eer_loop_watch(props->loop, &state->watch) == OK;
+    state->paused      = false;
+    // Loop hooks stay registered, a remounted input reuses its own
+    if (!state->hooked)
+        state->hooked = eer_loop_hook(props->loop, EER_LOOP_ON_ITERATION,
+                                      (eer_callback_t){eer_fd_resume, self})
+                        == OK;
+}
+
+SHOULD_UPDATE(FdInput) { return state->watch.ready; }
+
+WILL_UPDATE_SKIP(FdInput);
+
+/* One readv() into the free space of the ring, split where it wraps */
+RELEASE(FdInput)
+{
+    eer_ring_t  *ring     = props->buffer;
+    size_t       capacity = ring->mask + 1;
+    size_t       free     = capacity - eer_ring_count(ring);
+    size_t       first    = free;
+    struct iovec parts[2];
+    ssize_t      size;
+
+    if (state->closed)
+        return;
+    // A readable descriptor would wake the idle wait on every iteration
+    if (!free) {
+        state->watch.ready = false;
+        if (state->watched && state->hooked) {
+            eer_loop_unwatch(props->loop, &state->watch);
+            state->watched = false;
+            state->paused  = true;
+        }
+        return;
+    }
+
+    parts[0].iov_base = eer_ring_reserve(ring, &first);
+    parts[0].iov_len  = first;
+    parts[1].iov_base = ring->buffer;
+    parts[1].iov_len  = free - first;
+
+    size = readv(props->fd, parts, free > first ? 2 : 1);
+    state->reads += 1;
+    state->watch.ready = false;
+
+    if (size > 0) {
+        eer_ring_commit(ring, (size_t)size);
+        state->received += (uint64_t)size;
+    } else if (size < 0 && (EAGAIN == errno || EWOULDBLOCK == errno
+                            || EINTR == errno)) {
+        return;
+    } else {
+        state->closed = true;
+        state->error  = size < 0 ? errno : 0;
+        if (state->watched)
+            eer_loop_unwatch(props->loop, &state->watch);
+        state->watched = false;
+    }
+}
+
+DID_MOUNT_SKIP(FdInput);
+DID_UPDATE_SKIP(FdInput);
+
+DID_UNMOUNT(FdInput)
+{
+    if (state->watched)
+        eer_loop_unwatch(props->loop, &state->watch);
+    state->watched = false;
+}
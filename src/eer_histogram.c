@@ -0,0 +1,80 @@
+#include <eer_histogram.h>
+
+/* Values below 8 get a bucket each, larger ones 8 buckets per power of two */
+static unsigned eer_histogram_index(uint64_t value)
+{
+    if (value < EER_HISTOGRAM_SUBBUCKETS)
+        return (unsigned)value;
+
+    unsigned exponent = 63 - (unsigned)__builtin_clzll(value);
+    unsigned sub      = (unsigned)(value >> (exponent - 3)) & 7;
+
+    return (exponent - 2) * EER_HISTOGRAM_SUBBUCKETS + sub;
+}
+
+static uint64_t eer_histogram_upper(unsigned index)
+{
+    if (index < EER_HISTOGRAM_SUBBUCKETS)
+        return index;
+
+    unsigned exponent = index / EER_HISTOGRAM_SUBBUCKETS + 2;
+    uint64_t sub      = index % EER_HISTOGRAM_SUBBUCKETS;
+
+    return ((EER_HISTOGRAM_SUBBUCKETS + sub + 1) << (exponent - 3)) - 1;
+}
+
+void eer_histogram_add(eer_histogram_t *histogram, uint64_t value)
+{
+    unsigned index = eer_histogram_index(value);
+
+    if (index >= EER_HISTOGRAM_BUCKETS)
+        index = EER_HISTOGRAM_BUCKETS - 1;
+    histogram->buckets[index]++;
+
+    if (!histogram->count || value < histogram->min)
+        histogram->min = value;
+    if (value > histogram->max)
+        histogram->max = value;
+    histogram->count++;
+    histogram->sum += value;
+}
+
+uint64_t eer_histogram_percentile(eer_histogram_t *histogram,
+                                  double           percentile)
+{
+    uint64_t rank = (uint64_t)(histogram->count * percentile / 100.0);
+    uint64_t seen = 0;
+
+    if (!histogram->count)
+        return 0;
+    if (rank >= histogram->count)
+        rank = histogram->count - 1;
+
+    for (unsigned index = 0; index < EER_HISTOGRAM_BUCKETS; index++) {
+        seen += histogram->buckets[index];
+        if (seen > rank) {
+            uint64_t upper = eer_histogram_upper(index);
+
+            return upper < histogram->max ? upper : histogram->max;
+        }
+    }
+
+    return histogram->max;
+}
+
+void eer_histogram_report(eer_histogram_t *histogram, const char *name,
+                          FILE *output)
+{
+    fprintf(output,
+            "%s: count %llu min %llu mean %llu p50 %llu p99 %llu p99.9 %llu "
+            "max %llu\n",
+            name, (unsigned long long)histogram->count,
+            (unsigned long long)histogram->min,
+            (unsigned long long)(histogram->count
+                                     ? histogram->sum / histogram->count
+                                     : 0),
+            (unsigned long long)eer_histogram_percentile(histogram, 50),
+            (unsigned long long)eer_histogram_percentile(histogram, 99),
+            (unsigned long long)eer_histogram_percentile(histogram, 99.9),
+            (unsigned long long)histogram->max);
+}
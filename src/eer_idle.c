@@ -0,0 +1,282 @@
+#include <eer_idle.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+static uint64_t eer_idle_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+eer_result_t eer_idle_init(eer_idle_t *idle)
+{
+    struct epoll_event event = {.events = EPOLLIN};
+
+    idle->uniprocessor = sysconf(_SC_NPROCESSORS_ONLN) < 2;
+    idle->fd           = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    idle->poll = epoll_create1(EPOLL_CLOEXEC);
+    if (idle->fd < 0 || idle->poll < 0
+        || epoll_ctl(idle->poll, EPOLL_CTL_ADD, idle->fd, &event)) {
+        eer_idle_release(idle);
+        return ERROR_UNKNOWN;
+    }
+
+    return OK;
+}
+
+void eer_idle_release(eer_idle_t *idle)
+{
+    if (idle->fd >= 0)
+        close(idle->fd);
+    if (idle->poll >= 0)
+        close(idle->poll);
+    idle->fd = idle->poll = -1;
+}
+
+static void eer_idle_signal(eer_idle_t *idle)
+{
+    uint64_t one = 1;
+
+    if (idle->fd >= 0 && write(idle->fd, &one, sizeof(one)) < 0)
+        return; // The counter is already pending
+}
+
+eer_result_t eer_idle_watch(eer_idle_t *idle, struct eer_watch *watch)
+{
+    struct epoll_event event = {.events = EPOLLIN, .data.ptr = watch};
+
+    if (idle->poll < 0
+        || epoll_ctl(idle->poll, EPOLL_CTL_ADD, watch->fd, &event))
+        return ERROR_UNKNOWN;
+    idle->watches += 1;
+
+    return OK;
+}
+
+void eer_idle_unwatch(eer_idle_t *idle, struct eer_watch *watch)
+{
+    if (idle->poll >= 0
+        && !epoll_ctl(idle->poll, EPOLL_CTL_DEL, watch->fd, NULL))
+        idle->watches -= 1;
+    watch->ready = false;
+}
+
+/*
+ * Wait up to `timeout` ms (-1 forever) and mark the ready descriptors
+ * Returns true when a watched descriptor became readable
+ */
+static bool eer_idle_collect(eer_idle_t *idle, int timeout)
+{
+    struct epoll_event events[EER_IDLE_EVENTS];
+    uint64_t           count;
+    bool               ready = false;
+    int                total;
+
+    if (idle->poll < 0) {
+        sched_yield();
+        return false;
+    }
+
+    total = epoll_wait(idle->poll, events, EER_IDLE_EVENTS, timeout);
+    for (int index = 0; index < total; index++) {
+        struct eer_watch *watch = events[index].data.ptr;
+
+        if (watch) {
+            watch->ready = true;
+            ready        = true;
+        } else if (read(idle->fd, &count, sizeof(count)) < 0) {
+            continue; // Drained by an earlier wake-up
+        }
+    }
+
+    return ready;
+}
+
+#else
+#include <eer_hal.h>
+
+static uint64_t eer_idle_now(void) { return eer_now_us() * 1000; }
+
+eer_result_t eer_idle_init(eer_idle_t *idle)
+{
+    idle->fd = idle->poll = -1;
+
+    return ERROR_UNKNOWN;
+}
+
+void eer_idle_release(eer_idle_t *idle) { idle->fd = idle->poll = -1; }
+
+static void eer_idle_signal(eer_idle_t *idle) { (void)idle; }
+
+eer_result_t eer_idle_watch(eer_idle_t *idle, struct eer_watch *watch)
+{
+    (void)idle;
+    (void)watch;
+
+    return ERROR_UNKNOWN;
+}
+
+void eer_idle_unwatch(eer_idle_t *idle, struct eer_watch *watch)
+{
+    (void)idle;
+    watch->ready = false;
+}
+
+/* Sleeps up to EER_IDLE_NAP_US so notifications are seen without spinning */
+static bool eer_idle_collect(eer_idle_t *idle, int timeout)
+{
+    uint64_t nap = EER_IDLE_NAP_US;
+
+    (void)idle;
+    if (!timeout)
+        return false;
+    if (timeout > 0 && (uint64_t)timeout * 1000 < nap)
+        nap = (uint64_t)timeout * 1000;
+    eer_hw_timer.sleep_until(eer_now_us() + nap);
+
+    return false;
+}
+
+#endif
+
+static inline void eer_idle_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ volatile("yield");
+#endif
+}
+
+/* Without a scheduler the yield phase only relaxes the core */
+static inline void eer_idle_yield(void)
+{
+#ifdef __linux__
+    sched_yield();
+#else
+    eer_idle_relax();
+#endif
+}
+
+void eer_idle_notify(eer_idle_t *idle)
+{
+    __atomic_add_fetch(&idle->events, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&idle->sleeping, __ATOMIC_SEQ_CST))
+        eer_idle_signal(idle);
+}
+
+static bool eer_idle_pending(eer_idle_t *idle)
+{
+    return __atomic_load_n(&idle->events, __ATOMIC_SEQ_CST) != idle->seen;
+}
+
+/* Spin while events arrive within about two intervals, yield up to four */
+static void eer_idle_tune(eer_idle_t *idle)
+{
+    uint64_t window = 2 * idle->interval_ns / 1000;
+    uint64_t limit  = idle->spin_max_us;
+
+    idle->spin_us  = idle->interval_ns / 1000 < limit && !idle->uniprocessor
+                         ? (uint32_t)(window < limit ? window : limit)
+                         : 0;
+    idle->yield_us = idle->interval_ns / 1000 < 4 * limit
+                         ? (uint32_t)(window < 4 * limit ? window : 4 * limit)
+                         : 0;
+}
+
+/* An event ended the idle period in `phase` */
+static void eer_idle_woken(eer_idle_t *idle, enum eer_idle_phase phase,
+                           uint64_t now)
+{
+    int64_t sample = (int64_t)(now - idle->last_ns);
+
+    idle->seen = __atomic_load_n(&idle->events, __ATOMIC_SEQ_CST);
+    idle->counters[phase].wakes += 1;
+
+    if (idle->last_ns) {
+        // Exponential moving average over about eight events
+        idle->interval_ns = idle->interval_ns
+                                ? (uint64_t)((int64_t)idle->interval_ns
+                                             + (sample
+                                                - (int64_t)idle->interval_ns)
+                                                   / 8)
+                                : (uint64_t)sample;
+        if (idle->adaptive)
+            eer_idle_tune(idle);
+    }
+    idle->last_ns = now;
+}
+
+void eer_idle_wait(eer_idle_t *idle)
+{
+    uint64_t start = eer_idle_now();
+    uint64_t now   = start;
+    uint64_t spin  = (uint64_t)idle->spin_us * 1000;
+    uint64_t yield = spin + (uint64_t)idle->yield_us * 1000;
+
+    if (eer_idle_pending(idle)) {
+        if (idle->watches)
+            eer_idle_collect(idle, 0);
+        eer_idle_woken(idle, EER_IDLE_SPIN, now);
+        return;
+    }
+
+    while (now - start < spin) {
+        eer_idle_relax();
+        now = eer_idle_now();
+        if (eer_idle_pending(idle)) {
+            idle->counters[EER_IDLE_SPIN].time_ns += now - start;
+            eer_idle_woken(idle, EER_IDLE_SPIN, now);
+            return;
+        }
+    }
+    idle->counters[EER_IDLE_SPIN].time_ns += now - start;
+
+    uint64_t from = now;
+
+    while (now - start < yield) {
+        bool ready = idle->watches ? eer_idle_collect(idle, 0) : false;
+
+        eer_idle_yield();
+        now = eer_idle_now();
+        if (ready || eer_idle_pending(idle)) {
+            idle->counters[EER_IDLE_YIELD].time_ns += now - from;
+            eer_idle_woken(idle, EER_IDLE_YIELD, now);
+            return;
+        }
+    }
+    idle->counters[EER_IDLE_YIELD].time_ns += now - from;
+
+    from              = now;
+    uint64_t deadline = now + (uint64_t)idle->timeout_us * 1000;
+    bool     woken    = false;
+
+    // Producers write the eventfd only while `sleeping` is set
+    __atomic_store_n(&idle->sleeping, 1, __ATOMIC_SEQ_CST);
+    while (!(woken = eer_idle_pending(idle))) {
+        int timeout = -1;
+
+        if (idle->timeout_us) {
+            if (now >= deadline)
+                break;
+            timeout = (int)((deadline - now + 999999) / 1000000);
+        }
+        if ((woken = eer_idle_collect(idle, timeout)))
+            break;
+        now = eer_idle_now();
+    }
+    __atomic_store_n(&idle->sleeping, 0, __ATOMIC_SEQ_CST);
+
+    now = eer_idle_now();
+    idle->counters[EER_IDLE_BLOCK].time_ns += now - from;
+    if (woken)
+        eer_idle_woken(idle, EER_IDLE_BLOCK, now);
+}
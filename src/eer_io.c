@@ -0,0 +1,315 @@
+#include <eer_io.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* io_uring */
+
+static int eer_io_uring_setup(eer_io_t *io, uint32_t entries)
+{
+    struct io_uring_params params;
+    int                    fd;
+
+    memset(&params, 0, sizeof(params));
+    fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0)
+        return -1;
+
+    io->entries   = params.sq_entries;
+    io->sq_size   = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    io->cq_size   = params.cq_off.cqes
+                  + params.cq_entries * sizeof(struct io_uring_cqe);
+    io->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    // Kernels with a single mapping share it between both rings
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (io->cq_size > io->sq_size)
+            io->sq_size = io->cq_size;
+        io->cq_size = io->sq_size;
+    }
+
+    io->sq_ring = mmap(NULL, io->sq_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    io->cq_ring = params.features & IORING_FEAT_SINGLE_MMAP
+                      ? io->sq_ring
+                      : mmap(NULL, io->cq_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    io->sqes    = mmap(NULL, io->sqes_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    io->watch.fd = fd;
+    if (MAP_FAILED == io->sq_ring || MAP_FAILED == io->cq_ring
+        || MAP_FAILED == io->sqes) {
+        eer_io_release(io);
+        return -1;
+    }
+
+    io->sq_head  = (uint32_t *)((uint8_t *)io->sq_ring + params.sq_off.head);
+    io->sq_tail  = (uint32_t *)((uint8_t *)io->sq_ring + params.sq_off.tail);
+    io->sq_mask  = (uint32_t *)((uint8_t *)io->sq_ring + params.sq_off.ring_mask);
+    io->sq_array = (uint32_t *)((uint8_t *)io->sq_ring + params.sq_off.array);
+    io->cq_head  = (uint32_t *)((uint8_t *)io->cq_ring + params.cq_off.head);
+    io->cq_tail  = (uint32_t *)((uint8_t *)io->cq_ring + params.cq_off.tail);
+    io->cq_mask  = (uint32_t *)((uint8_t *)io->cq_ring + params.cq_off.ring_mask);
+    io->cqes     = (uint8_t *)io->cq_ring + params.cq_off.cqes;
+
+    return fd;
+}
+
+static void eer_io_uring_queue(eer_io_t *io, eer_io_request_t *request)
+{
+    uint32_t              tail  = *io->sq_tail;
+    uint32_t              index = tail & *io->sq_mask;
+    struct io_uring_sqe *sqe   = (struct io_uring_sqe *)io->sqes + index;
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = EER_IO_READ == request->op ? IORING_OP_READ : IORING_OP_WRITE;
+    sqe->fd        = request->fd;
+    sqe->addr      = (uint64_t)(uintptr_t)request->buffer;
+    sqe->len       = (uint32_t)request->size;
+    sqe->off       = (uint64_t)request->offset;
+    sqe->user_data = (uint64_t)(uintptr_t)request;
+
+    io->sq_array[index] = index;
+    __atomic_store_n(io->sq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+static size_t eer_io_uring_reap(eer_io_t *io)
+{
+    uint32_t head;
+    uint32_t tail;
+    size_t   completed = 0;
+
+    if (io->queued) {
+        int submitted = (int)syscall(__NR_io_uring_enter, io->watch.fd,
+                                     io->queued, 0, 0, NULL, 0);
+
+        io->syscalls += 1;
+        if (submitted > 0)
+            io->queued -= (uint32_t)submitted;
+    }
+
+    // Completions are read from shared memory, no syscall
+    head = *io->cq_head;
+    tail = __atomic_load_n(io->cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+        struct io_uring_cqe *cqe = (struct io_uring_cqe *)io->cqes
+                                   + (head & *io->cq_mask);
+        eer_io_request_t    *request
+            = (eer_io_request_t *)(uintptr_t)cqe->user_data;
+
+        request->result = cqe->res;
+        request->busy   = false;
+        request->done   = true;
+        io->inflight -= 1;
+        completed++;
+    }
+    __atomic_store_n(io->cq_head, head, __ATOMIC_RELEASE);
+
+    return completed;
+}
+
+/* epoll */
+
+#define eer_io_events(op) (EER_IO_READ == (op) ? EPOLLIN : EPOLLOUT)
+
+/* Register `fd` for the events of its pending requests, none removes it */
+static void eer_io_epoll_update(eer_io_t *io, int fd)
+{
+    struct epoll_event event = {.data.fd = fd};
+
+    for (eer_io_request_t *request = io->pending; request;
+         request                   = request->next)
+        if (request->fd == fd && !request->direct)
+            event.events |= eer_io_events(request->op);
+
+    io->syscalls += 1;
+    if (!event.events)
+        epoll_ctl(io->watch.fd, EPOLL_CTL_DEL, fd, NULL);
+    else if (epoll_ctl(io->watch.fd, EPOLL_CTL_MOD, fd, &event))
+        epoll_ctl(io->watch.fd, EPOLL_CTL_ADD, fd, &event);
+}
+
+static void eer_io_epoll_queue(eer_io_t *io, eer_io_request_t *request)
+{
+    struct epoll_event event = {.events  = eer_io_events(request->op),
+                                .data.fd = request->fd};
+    eer_io_request_t **link  = &io->pending;
+
+    while (*link)
+        link = &(*link)->next;
+    *link         = request;
+    request->next = NULL;
+
+    // Regular files cannot be polled and are accessed when reaped
+    io->syscalls += 1;
+    if (!epoll_ctl(io->watch.fd, EPOLL_CTL_ADD, request->fd, &event))
+        request->direct = false;
+    else if (!(request->direct = EPERM == errno))
+        eer_io_epoll_update(io, request->fd);
+}
+
+static bool eer_io_epoll_execute(eer_io_t *io, eer_io_request_t *request)
+{
+    ssize_t size;
+
+    io->syscalls += 1;
+    if (EER_IO_READ == request->op)
+        size = request->offset >= 0 ? pread(request->fd, request->buffer,
+                                            request->size, request->offset)
+                                    : read(request->fd, request->buffer,
+                                           request->size);
+    else
+        size = request->offset >= 0 ? pwrite(request->fd, request->buffer,
+                                             request->size, request->offset)
+                                    : write(request->fd, request->buffer,
+                                            request->size);
+
+    if (size < 0 && (EAGAIN == errno || EWOULDBLOCK == errno))
+        return false;
+
+    request->result = size < 0 ? -errno : size;
+    return true;
+}
+
+static size_t eer_io_epoll_reap(eer_io_t *io)
+{
+    struct epoll_event events[EER_IDLE_EVENTS];
+    int                ready     = 0;
+    size_t             completed = 0;
+    bool               polled    = false;
+
+    for (eer_io_request_t *request = io->pending; request && !polled;
+         request                   = request->next)
+        polled = !request->direct;
+    if (polled) {
+        io->syscalls += 1;
+        ready = epoll_wait(io->watch.fd, events, EER_IDLE_EVENTS, 0);
+    }
+    io->queued = 0;
+
+    for (eer_io_request_t **link = &io->pending; *link;) {
+        eer_io_request_t *request = *link;
+        bool              due     = request->direct;
+
+        for (int index = 0; !due && index < ready; index++)
+            due = events[index].data.fd == request->fd
+                  && events[index].events
+                         & (eer_io_events(request->op) | EPOLLERR | EPOLLHUP);
+
+        if (!due || !eer_io_epoll_execute(io, request)) {
+            link = &request->next;
+            continue;
+        }
+
+        *link           = request->next;
+        request->busy   = false;
+        request->done   = true;
+        io->inflight -= 1;
+        completed++;
+        if (!request->direct)
+            eer_io_epoll_update(io, request->fd);
+    }
+
+    return completed;
+}
+
+eer_result_t eer_io_init(eer_io_t *io, uint32_t entries,
+                         enum eer_io_backend backend)
+{
+    memset(io, 0, sizeof(*io));
+    io->watch.fd = -1;
+
+    if (EER_IO_URING == backend && eer_io_uring_setup(io, entries) >= 0) {
+        io->backend = EER_IO_URING;
+        return OK;
+    }
+
+    io->backend  = EER_IO_EPOLL;
+    io->entries  = entries;
+    io->watch.fd = epoll_create1(EPOLL_CLOEXEC);
+
+    return io->watch.fd < 0 ? ERROR_UNKNOWN : OK;
+}
+
+void eer_io_release(eer_io_t *io)
+{
+    if (EER_IO_URING == io->backend) {
+        if (io->sqes && MAP_FAILED != io->sqes)
+            munmap(io->sqes, io->sqes_size);
+        if (io->cq_ring && MAP_FAILED != io->cq_ring
+            && io->cq_ring != io->sq_ring)
+            munmap(io->cq_ring, io->cq_size);
+        if (io->sq_ring && MAP_FAILED != io->sq_ring)
+            munmap(io->sq_ring, io->sq_size);
+    }
+    if (io->watch.fd >= 0)
+        close(io->watch.fd);
+    io->sqes = io->cq_ring = io->sq_ring = NULL;
+    io->watch.fd                         = -1;
+}
+
+eer_result_t eer_io_submit(eer_io_t *io, eer_io_request_t *request)
+{
+    if (request->busy)
+        return ERROR_BUFFER_BUSY;
+    if (io->inflight >= io->entries)
+        return ERROR_BUFFER_FULL;
+
+    request->busy = true;
+    request->done = false;
+    if (EER_IO_URING == io->backend)
+        eer_io_uring_queue(io, request);
+    else
+        eer_io_epoll_queue(io, request);
+    io->queued += 1;
+    io->inflight += 1;
+
+    return OK;
+}
+
+size_t eer_io_reap(eer_io_t *io)
+{
+    if (!io->inflight)
+        return 0;
+
+    return EER_IO_URING == io->backend ? eer_io_uring_reap(io)
+                                       : eer_io_epoll_reap(io);
+}
+
+#else
+
+eer_result_t eer_io_init(eer_io_t *io, uint32_t entries,
+                         enum eer_io_backend backend)
+{
+    (void)entries;
+    memset(io, 0, sizeof(*io));
+    io->backend  = backend;
+    io->watch.fd = -1;
+
+    return ERROR_UNKNOWN;
+}
+
+void eer_io_release(eer_io_t *io) { io->watch.fd = -1; }
+
+eer_result_t eer_io_submit(eer_io_t *io, eer_io_request_t *request)
+{
+    (void)io;
+    (void)request;
+
+    return ERROR_UNKNOWN;
+}
+
+size_t eer_io_reap(eer_io_t *io)
+{
+    (void)io;
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,421 @@
+#include <eer_journal.h>
+#include <string.h>
+
+/* Start of every sector of the region */
+struct eer_journal_sector {
+    uint32_t magic;
+    uint32_t sequence; /* Higher for newer checkpoints */
+    uint32_t erases;   /* Times the sector was erased */
+    uint32_t layout;
+};
+
+struct eer_journal_record {
+    uint16_t size; /* UINT16_MAX where the flash is still erased */
+    uint16_t offset;
+    uint8_t  entry;
+    uint8_t  last; /* Last record of a commit or checkpoint */
+    uint16_t check;
+};
+
+#define EER_JOURNAL_PAYLOAD                                                    \
+    (EER_JOURNAL_RECORD - sizeof(struct eer_journal_record))
+
+struct eer_journal_frame {
+    struct eer_journal_record record;
+    uint8_t                   data[EER_JOURNAL_PAYLOAD];
+};
+
+static uint32_t eer_journal_align(size_t size)
+{
+    return (uint32_t)(size + 3) & ~3u;
+}
+
+static uint32_t eer_journal_address(eer_journal_t *journal, uint16_t sector,
+                                    uint32_t offset)
+{
+    return (uint32_t)(journal->first + sector) * journal->sector_size
+           + offset;
+}
+
+/* Fletcher-16 of the record header and data, never 0xFFFF */
+static uint16_t eer_journal_check(const struct eer_journal_frame *frame)
+{
+    const uint8_t *header = (const uint8_t *)&frame->record;
+    uint16_t       sum = 0, total = 0;
+
+    for (size_t index = 0; index < offsetof(struct eer_journal_record, check);
+         index++) {
+        sum   = (sum + header[index]) % 255;
+        total = (total + sum) % 255;
+    }
+    for (size_t index = 0; index < frame->record.size; index++) {
+        sum   = (sum + frame->data[index]) % 255;
+        total = (total + sum) % 255;
+    }
+
+    return (uint16_t)(total << 8 | sum);
+}
+
+static bool eer_journal_fits(eer_journal_t *journal, size_t size)
+{
+    return journal->position
+               + eer_journal_align(sizeof(struct eer_journal_record) + size)
+           <= journal->sector_size;
+}
+
+eer_result_t eer_journal_register(eer_journal_t *journal, eer_t *instance,
+                                  void *data, size_t size, const char *name)
+{
+    uint32_t layout = journal->count ? journal->layout : 0x811c9dc5u;
+
+    if (journal->count >= journal->capacity || journal->count > UINT8_MAX
+        || size > UINT16_MAX || journal->pool_used + size > journal->pool_size)
+        return ERROR_BUFFER_FULL;
+
+    // FNV-1a of the names and sizes in order of registration
+    while (*name) {
+        layout ^= (uint8_t)*name++;
+        layout *= 0x01000193u;
+    }
+    layout ^= (uint32_t)size;
+    layout *= 0x01000193u;
+
+    journal->entries[journal->count++] = (struct eer_journal_entry){
+        .instance = instance,
+        .data     = data,
+        .shadow   = journal->pool + journal->pool_used,
+        .size     = size};
+    journal->pool_used += size;
+    journal->layout = layout;
+
+    return OK;
+}
+
+/* Program one record with `size` bytes of an entry at `offset` */
+static eer_result_t eer_journal_write(eer_journal_t *journal, uint16_t sector,
+                                      uint8_t entry, size_t offset, size_t size,
+                                      bool last)
+{
+    struct eer_journal_entry *item  = &journal->entries[entry];
+    struct eer_journal_frame  frame = {
+         .record = {.size   = (uint16_t)size,
+                    .offset = (uint16_t)offset,
+                    .entry  = entry,
+                    .last   = last}};
+    uint32_t bytes = eer_journal_align(sizeof(frame.record) + size);
+    uint32_t address = eer_journal_address(journal, sector, journal->position);
+
+    memcpy(frame.data, item->data + offset, size);
+    memset(frame.data + size, 0xFF, sizeof(frame.data) - size);
+    frame.record.check = eer_journal_check(&frame);
+
+    // A failed program leaves the sector full, the next commit compacts
+    journal->position += bytes;
+    if (OK != eer_hw_flash.program(address, &frame, bytes)) {
+        journal->position = journal->sector_size;
+        return ERROR_UNKNOWN;
+    }
+
+    memcpy(item->shadow + offset, item->data + offset, size);
+    journal->written += bytes;
+
+    return OK;
+}
+
+static bool eer_journal_blank(eer_journal_t *journal, uint16_t sector)
+{
+    uint8_t chunk[256];
+
+    for (uint32_t offset = 0; offset < journal->sector_size;
+         offset += sizeof(chunk)) {
+        size_t size = journal->sector_size - offset < sizeof(chunk)
+                          ? journal->sector_size - offset
+                          : sizeof(chunk);
+
+        if (OK != eer_hw_flash.read(eer_journal_address(journal, sector, offset),
+                                 chunk, size))
+            return false;
+        for (size_t index = 0; index < size; index++)
+            if (0xFF != chunk[index])
+                return false;
+    }
+
+    return true;
+}
+
+eer_result_t eer_journal_compact(eer_journal_t *journal)
+{
+    struct eer_journal_sector header;
+    uint16_t                  target = EER_JOURNAL_NONE;
+    uint16_t                  start;
+    uint32_t                  erases = UINT32_MAX;
+
+    if (!journal->sector_size)
+        return ERROR_UNKNOWN;
+
+    // Least erased sector, the one after the active sector on a tie
+    start = EER_JOURNAL_NONE == journal->active ? journal->sectors - 1
+                                                : journal->active;
+    for (uint16_t step = 1; step <= journal->sectors; step++) {
+        uint16_t sector = (uint16_t)((start + step) % journal->sectors);
+        uint32_t count;
+
+        if (sector == journal->active)
+            continue;
+        if (OK != eer_hw_flash.read(eer_journal_address(journal, sector, 0),
+                                 &header, sizeof(header)))
+            return ERROR_UNKNOWN;
+
+        count = EER_JOURNAL_MAGIC == header.magic ? header.erases : 0;
+        if (count < erases) {
+            erases = count;
+            target = sector;
+        }
+    }
+
+    // The active sector holds the last checkpoint until this one is complete
+    journal->position = journal->sector_size;
+    journal->sequence = journal->sequence + 1;
+    if (!eer_journal_blank(journal, target)) {
+        if (OK != eer_hw_flash.erase(journal->first + target))
+            return ERROR_UNKNOWN;
+        erases += 1;
+        journal->erases += 1;
+    }
+
+    header = (struct eer_journal_sector){.magic    = EER_JOURNAL_MAGIC,
+                                         .sequence = journal->sequence,
+                                         .erases   = erases,
+                                         .layout   = journal->layout};
+    if (OK != eer_hw_flash.program(eer_journal_address(journal, target, 0),
+                                &header, sizeof(header)))
+        return ERROR_UNKNOWN;
+
+    journal->position = sizeof(header);
+    journal->written += sizeof(header);
+
+    for (size_t entry = 0; entry < journal->count; entry++) {
+        size_t size = journal->entries[entry].size;
+
+        for (size_t offset = 0, chunk; offset < size; offset += chunk) {
+            chunk = size - offset < EER_JOURNAL_PAYLOAD ? size - offset
+                                                        : EER_JOURNAL_PAYLOAD;
+            if (OK != eer_journal_write(journal, target, (uint8_t)entry, offset,
+                                        chunk,
+                                        entry + 1 == journal->count
+                                            && offset + chunk == size))
+                return ERROR_UNKNOWN;
+        }
+    }
+
+    journal->active = target;
+    journal->compactions += 1;
+
+    return OK;
+}
+
+eer_result_t eer_journal_commit(eer_journal_t *journal)
+{
+    uint8_t entry_pending = 0;
+    size_t  offset_pending = 0, size_pending = 0;
+
+    if (!journal->sector_size)
+        return ERROR_UNKNOWN;
+    if (EER_JOURNAL_NONE == journal->active)
+        return eer_journal_compact(journal);
+
+    for (size_t entry = 0; entry < journal->count; entry++) {
+        struct eer_journal_entry *item = &journal->entries[entry];
+
+        if (!memcmp(item->data, item->shadow, item->size))
+            continue;
+
+        for (size_t offset = 0; offset < item->size;) {
+            size_t end = offset + 1;
+
+            if (item->data[offset] == item->shadow[offset]) {
+                offset++;
+                continue;
+            }
+
+            // Join changes closer than a record header into one record
+            for (size_t index = end, same = 0;
+                 index < item->size && same < sizeof(struct eer_journal_record);
+                 index++) {
+                if (item->data[index] != item->shadow[index]) {
+                    end  = index + 1;
+                    same = 0;
+                } else {
+                    same++;
+                }
+            }
+
+            // The last record of the commit is written once the scan ends
+            for (size_t chunk; offset < end; offset += chunk) {
+                chunk = end - offset < EER_JOURNAL_PAYLOAD
+                            ? end - offset
+                            : EER_JOURNAL_PAYLOAD;
+                if (size_pending) {
+                    if (!eer_journal_fits(journal, size_pending))
+                        return eer_journal_compact(journal);
+                    if (OK != eer_journal_write(journal, journal->active,
+                                                entry_pending,
+                                                offset_pending, size_pending,
+                                                false))
+                        return ERROR_UNKNOWN;
+                    journal->records += 1;
+                    journal->changed += size_pending;
+                }
+                entry_pending  = (uint8_t)entry;
+                offset_pending = offset;
+                size_pending   = chunk;
+            }
+        }
+    }
+
+    if (!size_pending)
+        return OK;
+    if (!eer_journal_fits(journal, size_pending))
+        return eer_journal_compact(journal);
+    if (OK != eer_journal_write(journal, journal->active, entry_pending,
+                                offset_pending, size_pending, true))
+        return ERROR_UNKNOWN;
+
+    journal->records += 1;
+    journal->changed += size_pending;
+    journal->commits += 1;
+
+    return OK;
+}
+
+/* Read the record at `*position`, false at erased flash or a torn record */
+static bool eer_journal_read(eer_journal_t *journal, uint16_t sector,
+                             uint32_t *position,
+                             struct eer_journal_frame *frame)
+{
+    struct eer_journal_record *record = &frame->record;
+    uint32_t                   bytes;
+
+    if (*position + sizeof(*record) > journal->sector_size
+        || OK != eer_hw_flash.read(eer_journal_address(journal, sector, *position),
+                                record, sizeof(*record)))
+        return false;
+
+    bytes = eer_journal_align(sizeof(*record) + record->size);
+    if (record->size > EER_JOURNAL_PAYLOAD || record->entry >= journal->count
+        || record->offset + record->size
+               > journal->entries[record->entry].size
+        || *position + bytes > journal->sector_size
+        || OK != eer_hw_flash.read(eer_journal_address(journal, sector,
+                                                    *position + sizeof(*record)),
+                                frame->data, record->size)
+        || eer_journal_check(frame) != record->check)
+        return false;
+
+    *position += bytes;
+
+    return true;
+}
+
+/* End of the last complete commit in `sector`, 0 without a checkpoint */
+static uint32_t eer_journal_scan(eer_journal_t *journal, uint16_t sector,
+                                 uint32_t *end)
+{
+    struct eer_journal_frame frame;
+    uint32_t                 complete = 0;
+
+    *end = sizeof(struct eer_journal_sector);
+    while (eer_journal_read(journal, sector, end, &frame))
+        if (frame.record.last)
+            complete = *end;
+
+    return complete;
+}
+
+eer_result_t eer_journal_open(eer_journal_t *journal, uint16_t first,
+                              uint16_t sectors)
+{
+    struct eer_journal_sector header;
+    struct eer_journal_frame  frame;
+    size_t                    checkpoint = sizeof(header);
+    uint64_t                  bound      = UINT64_MAX;
+    uint32_t                  complete = 0, end = 0;
+    uint16_t                  newest = EER_JOURNAL_NONE;
+
+    for (size_t entry = 0; entry < journal->count; entry++) {
+        size_t size = journal->entries[entry].size;
+
+        checkpoint += size / EER_JOURNAL_PAYLOAD * EER_JOURNAL_RECORD;
+        if (size % EER_JOURNAL_PAYLOAD)
+            checkpoint += eer_journal_align(sizeof(struct eer_journal_record)
+                                            + size % EER_JOURNAL_PAYLOAD);
+    }
+
+    if (sectors < 2 || checkpoint > eer_hw_flash.sector_size() / 2)
+        return ERROR_BUFFER_FULL;
+    if (!journal->count || first + sectors > eer_hw_flash.sectors())
+        return ERROR_UNKNOWN;
+
+    journal->first       = first;
+    journal->sectors     = sectors;
+    journal->sector_size = eer_hw_flash.sector_size();
+    journal->active      = EER_JOURNAL_NONE;
+    journal->sequence    = 0;
+
+    // Newest sector of these components whose checkpoint is complete
+    while (!complete) {
+        uint64_t sequence = 0;
+
+        newest = EER_JOURNAL_NONE;
+        for (uint16_t sector = 0; sector < sectors; sector++) {
+            if (OK != eer_hw_flash.read(eer_journal_address(journal, sector, 0),
+                                     &header, sizeof(header))
+                || EER_JOURNAL_MAGIC != header.magic)
+                continue;
+            if (header.sequence > journal->sequence)
+                journal->sequence = header.sequence;
+            if (journal->layout == header.layout && header.sequence < bound
+                && (EER_JOURNAL_NONE == newest || header.sequence > sequence)) {
+                newest   = sector;
+                sequence = header.sequence;
+            }
+        }
+
+        if (EER_JOURNAL_NONE == newest)
+            return ERROR_UNKNOWN;
+
+        complete = eer_journal_scan(journal, newest, &end);
+        bound    = sequence;
+    }
+
+    // Replay up to the end of the last complete commit
+    for (uint32_t position = sizeof(header); position < complete;) {
+        struct eer_journal_entry *item;
+
+        eer_journal_read(journal, newest, &position, &frame);
+        item = &journal->entries[frame.record.entry];
+        memcpy(item->data + frame.record.offset, frame.data, frame.record.size);
+    }
+
+    for (size_t entry = 0; entry < journal->count; entry++) {
+        struct eer_journal_entry *item = &journal->entries[entry];
+
+        memcpy(item->shadow, item->data, item->size);
+        // Checkpoints hold no versions, the restore counts as a release
+        item->instance->version += 1;
+        eer_staging_restore(item->instance);
+    }
+
+    // Records after the last complete commit are never replayed, appending
+    // behind them would: a torn or unfinished tail moves to a new sector
+    journal->active   = newest;
+    journal->position = journal->sector_size;
+    if (end == complete
+        && (end + sizeof(frame.record) > journal->sector_size
+            || (OK == eer_hw_flash.read(eer_journal_address(journal, newest, end),
+                                     &frame.record, sizeof(frame.record))
+                && UINT16_MAX == frame.record.size)))
+        journal->position = complete;
+
+    return OK;
+}
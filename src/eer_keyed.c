@@ -0,0 +1,175 @@
+#include <eer_keyed.h>
+#include <string.h>
+
+#define EER_KEYED_STABLE 0x80000000u /* Kept in place, set in targets */
+
+static eer_t *eer_keyed_slot(eer_keyed_t *keyed, uint32_t slot)
+{
+    return (eer_t *)(keyed->children + (size_t)slot * keyed->stride);
+}
+
+/* Every slot starts free with the lifecycle of the child type */
+static void eer_keyed_prepare(eer_keyed_t *keyed)
+{
+    for (size_t slot = 0; slot < keyed->capacity; slot++) {
+        *eer_keyed_slot(keyed, (uint32_t)slot) = keyed->prototype;
+        keyed->free[slot] = (uint32_t)(keyed->capacity - 1 - slot);
+    }
+    keyed->free_count = keyed->capacity;
+    keyed->ready      = true;
+}
+
+static void eer_keyed_unmount(eer_keyed_t *keyed, uint32_t slot)
+{
+    eer_staging_unmount(eer_keyed_slot(keyed, slot), &keyed->prototype);
+    keyed->free[keyed->free_count++] = slot;
+    keyed->unmounts += 1;
+}
+
+static size_t eer_keyed_hash(uint64_t key, size_t size)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+
+    return (size_t)(key % size);
+}
+
+/* Entry holding `key`, or the free entry where it belongs */
+static struct eer_keyed_entry *eer_keyed_find(eer_keyed_t *keyed,
+                                              const uint64_t *keys,
+                                              uint64_t key)
+{
+    size_t size  = 2 * keyed->capacity;
+    size_t index = eer_keyed_hash(key, size);
+
+    for (;; index = (index + 1) % size) {
+        struct eer_keyed_entry *entry = &keyed->table[index];
+
+        if (entry->generation != keyed->generation)
+            return entry;
+        if (key
+            == (entry->value < keyed->capacity
+                    ? keyed->keys[keyed->order[entry->value]]
+                    : keys[entry->value - keyed->capacity]))
+            return entry;
+    }
+}
+
+/* Mark the kept children on the longest run of increasing old positions */
+static void eer_keyed_stable(eer_keyed_t *keyed, size_t count)
+{
+    size_t length = 0;
+
+    for (size_t index = 0; index < count; index++) {
+        uint32_t source = keyed->sources[index];
+        size_t   low = 0, high = length;
+
+        if (EER_KEYED_NONE == source)
+            continue;
+        while (low < high) {
+            size_t middle = (low + high) / 2;
+
+            if (keyed->sources[keyed->tails[middle]] < source)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        keyed->previous[index] = low ? keyed->tails[low - 1] : EER_KEYED_NONE;
+        keyed->tails[low]      = (uint32_t)index;
+        if (low == length)
+            length++;
+    }
+
+    for (uint32_t index = length ? keyed->tails[length - 1] : EER_KEYED_NONE;
+         EER_KEYED_NONE != index; index = keyed->previous[index])
+        keyed->targets[keyed->sources[index]] |= EER_KEYED_STABLE;
+}
+
+eer_result_t eer_keyed_reconcile(eer_keyed_t *keyed, const uint64_t *keys,
+                                 size_t count)
+{
+    if (count > keyed->capacity)
+        return ERROR_BUFFER_FULL;
+    if (!keyed->ready)
+        eer_keyed_prepare(keyed);
+
+    // A new generation empties the table without clearing it
+    if (!++keyed->generation) {
+        memset(keyed->table, 0, 2 * keyed->capacity * sizeof(*keyed->table));
+        keyed->generation = 1;
+    }
+
+    for (size_t position = 0; position < keyed->count; position++) {
+        *eer_keyed_find(keyed, keys, eer_keyed_key(keyed, position))
+            = (struct eer_keyed_entry){(uint32_t)position, keyed->generation};
+        keyed->targets[position] = EER_KEYED_NONE;
+    }
+
+    for (size_t index = 0; index < count; index++) {
+        struct eer_keyed_entry *entry
+            = eer_keyed_find(keyed, keys, keys[index]);
+
+        if (entry->generation != keyed->generation) {
+            *entry = (struct eer_keyed_entry){
+                (uint32_t)(keyed->capacity + index), keyed->generation};
+            keyed->sources[index] = EER_KEYED_NONE;
+            continue;
+        }
+        if (entry->value >= keyed->capacity
+            || EER_KEYED_NONE != keyed->targets[entry->value])
+            return ERROR_UNKNOWN; // Repeated key
+
+        keyed->sources[index]        = entry->value;
+        keyed->targets[entry->value] = (uint32_t)index;
+    }
+
+    eer_keyed_stable(keyed, count);
+
+    for (size_t position = 0; position < keyed->count; position++)
+        if (EER_KEYED_NONE == keyed->targets[position])
+            eer_keyed_unmount(keyed, keyed->order[position]);
+
+    for (size_t index = 0; index < count; index++) {
+        uint32_t source = keyed->sources[index];
+        uint32_t slot;
+        eer_t   *child;
+
+        keyed->props(keyed->context, index, keys[index], keyed->next_props);
+
+        if (EER_KEYED_NONE == source) {
+            // DEFINED child, will_mount copies the props
+            slot              = keyed->free[--keyed->free_count];
+            child             = eer_keyed_slot(keyed, slot);
+            keyed->keys[slot] = keys[index];
+            eer_staging(child, keyed->next_props);
+            keyed->mounts += 1;
+        } else {
+            slot  = keyed->order[source];
+            child = eer_keyed_slot(keyed, slot);
+
+            if (!(keyed->targets[source] & EER_KEYED_STABLE)) {
+                keyed->moves += 1;
+                if (keyed->move)
+                    keyed->move(keyed->context, child, source, index);
+            }
+            if (eer_staging_update(child,
+                                   (uint8_t *)child + keyed->props_offset,
+                                   keyed->next_props, keyed->props_size))
+                keyed->updates += 1;
+        }
+        keyed->next_order[index] = slot;
+    }
+
+    memcpy(keyed->order, keyed->next_order, count * sizeof(*keyed->order));
+    keyed->count = count;
+
+    return OK;
+}
+
+void eer_keyed_shut(eer_keyed_t *keyed)
+{
+    for (size_t position = 0; position < keyed->count; position++)
+        eer_keyed_unmount(keyed, keyed->order[position]);
+    keyed->count = 0;
+}
@@ -0,0 +1,101 @@
+#include <eer_list.h>
+
+static size_t eer_list_last_offset(eer_list_t *list)
+{
+    return list->count > list->window ? list->count - list->window : 0;
+}
+
+/* Slots start free with the lifecycle of the child type */
+static bool eer_list_prepare(eer_list_t *list)
+{
+    // Without rows there is no slot to place item `offset % window` in
+    if (!list->window)
+        return false;
+    for (uint16_t slot = 0; slot < list->window; slot++) {
+        *eer_list_child(list, slot) = list->prototype;
+        list->bound[slot]           = EER_LIST_NONE;
+    }
+    list->ready = true;
+
+    return true;
+}
+
+static void eer_list_unmount(eer_list_t *list, uint16_t slot)
+{
+    eer_staging_unmount(eer_list_child(list, slot), &list->prototype);
+    list->bound[slot] = EER_LIST_NONE;
+    list->unmounts += 1;
+}
+
+void eer_list_resize(eer_list_t *list, size_t count)
+{
+    list->count = count;
+    if (list->offset > eer_list_last_offset(list))
+        list->offset = eer_list_last_offset(list);
+}
+
+void eer_list_scroll(eer_list_t *list, size_t offset)
+{
+    list->offset = offset < eer_list_last_offset(list)
+                       ? offset
+                       : eer_list_last_offset(list);
+}
+
+enum eer_context eer_list_staging(eer_list_t *list)
+{
+    enum eer_context context = EER_CONTEXT_SAME;
+    size_t           first;
+
+    if (!list->ready && !eer_list_prepare(list))
+        return context;
+    first = list->offset % list->window;
+
+    for (uint16_t slot = 0; slot < list->window; slot++) {
+        eer_t  *child = eer_list_child(list, slot);
+        void   *props = (uint8_t *)child + list->props_offset;
+        size_t  item  = list->offset + (slot + list->window - first) % list->window;
+
+        if (item >= list->count) {
+            if (EER_LIST_NONE != list->bound[slot]) {
+                eer_list_unmount(list, slot);
+                context = EER_CONTEXT_UPDATED;
+            }
+            continue;
+        }
+
+        list->item(list->context, item, (uint16_t)(item - list->offset),
+                   list->next_props);
+
+        if (EER_LIST_NONE == list->bound[slot]) {
+            // DEFINED child, will_mount copies the props
+            list->mounts += 1;
+        } else if (list->bound[slot] != item) {
+            // The slot shows another item, update without remounting
+            child->stage.state.step = EER_STAGE_REACTING;
+            list->recycles += 1;
+        } else {
+            if (eer_staging_update(child, props, list->next_props,
+                                   list->props_size)) {
+                list->updates += 1;
+                context = EER_CONTEXT_UPDATED;
+            }
+            continue;
+        }
+
+        eer_staging(child, list->next_props);
+        list->bound[slot] = item;
+        context           = EER_CONTEXT_UPDATED;
+    }
+
+    return context;
+}
+
+void eer_list_shut(eer_list_t *list)
+{
+    if (!list->ready)
+        return;
+
+    for (uint16_t slot = 0; slot < list->window; slot++)
+        if (EER_LIST_NONE != list->bound[slot])
+            eer_list_unmount(list, slot);
+}
@@ -0,0 +1,204 @@
+#include <eer_loop.h>
+#include <string.h>
+
+static void eer_loop_execute(eer_loop_t *loop, enum eer_loop_event event)
+{
+    for (uint8_t index = 0; index < loop->hook_count; index++) {
+        struct eer_loop_hook *hook = &loop->hooks[index];
+
+        if (hook->event == event)
+            hook->callback.method(hook->callback.argument, loop);
+    }
+}
+
+void eer_loop_init(eer_loop_t *loop, eer_registry_t *registry)
+{
+    memset(loop, 0, sizeof(*loop));
+    loop->registry = registry;
+}
+
+eer_result_t eer_loop_hook(eer_loop_t *loop, enum eer_loop_event event,
+                           eer_callback_t callback)
+{
+    if (loop->hook_count >= EER_LOOP_HOOKS)
+        return ERROR_BUFFER_FULL;
+
+    loop->hooks[loop->hook_count].event    = event;
+    loop->hooks[loop->hook_count].callback = callback;
+    loop->hook_count += 1;
+
+    return OK;
+}
+
+void eer_loop_configure(eer_loop_t *loop, const eer_loop_attr_t *attr)
+{
+    loop->attr = attr;
+}
+
+void eer_loop_callbacks(eer_loop_t *loop, eer_mpmc_t *queue, size_t budget)
+{
+    loop->callbacks       = queue;
+    loop->callback_budget = budget;
+}
+
+void eer_loop_pace(eer_loop_t *loop, uint32_t hz)
+{
+    // The timer counts microseconds, faster rates run once per microsecond
+    loop->period = hz ? (hz < 1000000 ? 1000000 / hz : 1) : 0;
+}
+
+void eer_loop_spin(eer_loop_t *loop, uint32_t us) { loop->spin = us; }
+
+void eer_loop_jitter(eer_loop_t *loop, eer_histogram_t *histogram)
+{
+    loop->jitter = histogram;
+}
+
+void eer_loop_idle(eer_loop_t *loop, eer_idle_t *idle) { loop->idle = idle; }
+
+void eer_loop_wake(eer_loop_t *loop)
+{
+    if (loop->idle)
+        eer_idle_notify(loop->idle);
+}
+
+eer_result_t eer_loop_watch(eer_loop_t *loop, struct eer_watch *watch)
+{
+    if (!loop->idle)
+        return ERROR_UNKNOWN;
+
+    return eer_idle_watch(loop->idle, watch);
+}
+
+void eer_loop_unwatch(eer_loop_t *loop, struct eer_watch *watch)
+{
+    if (loop->idle)
+        eer_idle_unwatch(loop->idle, watch);
+}
+
+void eer_loop_io(eer_loop_t *loop, eer_io_t *io)
+{
+    loop->io = io;
+    if (loop->idle && io->watch.fd >= 0)
+        eer_idle_watch(loop->idle, &io->watch);
+}
+
+eer_result_t eer_loop_defer(eer_loop_t *loop, eer_callback_t callback)
+{
+    eer_result_t result;
+
+    if (!loop->callbacks)
+        return ERROR_UNKNOWN;
+
+    result = eer_mpmc_push(loop->callbacks, &callback);
+    if (OK == result)
+        eer_loop_wake(loop);
+
+    return result;
+}
+
+/* Wait for the next deadline of a paced loop */
+static void eer_loop_wait(eer_loop_t *loop)
+{
+    uint64_t now = eer_hw_timer.now();
+
+    if (now > loop->deadline) {
+        if (loop->jitter)
+            eer_histogram_add(loop->jitter, now - loop->deadline);
+        // Skip the missed periods so later iterations keep their phase
+        loop->overruns += 1;
+        loop->deadline += (now - loop->deadline) / loop->period * loop->period
+                          + loop->period;
+        return;
+    }
+
+    if (loop->spin && loop->deadline - now > loop->spin)
+        eer_hw_timer.sleep_until(loop->deadline - loop->spin);
+    if (loop->spin)
+        eer_hw_timer.spin_until(loop->deadline);
+    else
+        eer_hw_timer.sleep_until(loop->deadline);
+
+    if (loop->jitter)
+        eer_histogram_add(loop->jitter, eer_hw_timer.now() - loop->deadline);
+    loop->deadline += loop->period;
+}
+
+static void eer_loop_drain(eer_loop_t *loop)
+{
+    size_t         budget = eer_mpmc_count(loop->callbacks);
+    eer_callback_t callback;
+
+    if (loop->callback_budget && budget > loop->callback_budget)
+        budget = loop->callback_budget;
+
+    while (budget-- && eer_mpmc_pop(loop->callbacks, &callback) == OK)
+        callback.method(callback.argument, loop);
+}
+
+void eer_loop_stop(eer_loop_t *loop)
+{
+    __atomic_store_n(&loop->stopping, 1, __ATOMIC_RELEASE);
+    eer_loop_wake(loop);
+}
+
+uint64_t eer_loop_iteration(eer_loop_t *loop)
+{
+    return __atomic_load_n(&loop->iteration, __ATOMIC_ACQUIRE);
+}
+
+union eer_land eer_loop_begin(eer_loop_t *loop)
+{
+    loop->land.flags = 0;
+    if (loop->attr)
+        loop->realtime_failed = eer_realtime_apply(loop->attr);
+    eer_loop_execute(loop, EER_LOOP_ON_START);
+    if (loop->period)
+        loop->deadline = eer_hw_timer.now() + loop->period;
+
+    return loop->land;
+}
+
+bool eer_loop_running(eer_loop_t *loop, union eer_land *land,
+                      enum eer_context context)
+{
+    land->state.context = context;
+    if (__atomic_load_n(&loop->stopping, __ATOMIC_ACQUIRE))
+        land->state.unmounted = true;
+    loop->land = *land;
+
+    if (!land->state.unmounted && land->state.context)
+        return true;
+
+    eer_loop_execute(loop, EER_LOOP_ON_EXIT);
+
+    return false;
+}
+
+void eer_loop_next(eer_loop_t *loop, union eer_land *land)
+{
+    size_t completed = 0;
+    bool   pending;
+
+    if (loop->registry)
+        eer_registry_staging(loop->registry);
+    if (loop->callbacks)
+        eer_loop_drain(loop);
+    if (loop->io)
+        completed = eer_io_reap(loop->io);
+    // Components applied in this iteration release in the next one
+    pending = eer_staging_pending();
+
+    loop->land = *land;
+    __atomic_store_n(&loop->iteration, loop->iteration + 1, __ATOMIC_RELEASE);
+    eer_loop_execute(loop, EER_LOOP_ON_ITERATION);
+    // The loop exits without waiting for another iteration
+    if (land->state.unmounted
+        || __atomic_load_n(&loop->stopping, __ATOMIC_ACQUIRE))
+        return;
+    if (loop->period)
+        eer_loop_wait(loop);
+    else if (loop->idle && !completed && !pending
+             && !(loop->callbacks && eer_mpmc_count(loop->callbacks)))
+        eer_idle_wait(loop->idle);
+}
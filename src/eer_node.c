@@ -0,0 +1,106 @@
+#include <eer_node.h>
+
+void eer_node_attach(eer_node_t *parent, eer_node_t *child)
+{
+    eer_node_t **link = &parent->child;
+
+    while (*link)
+        link = &(*link)->sibling;
+    *link          = child;
+    child->parent  = parent;
+    child->sibling = NULL;
+}
+
+static bool eer_node_mounted(eer_t *instance)
+{
+    return EER_STAGE_RELEASED == instance->stage.state.step
+           || EER_STAGE_REACTING == instance->stage.state.step
+           || EER_STAGE_PREPARED == instance->stage.state.step;
+}
+
+static size_t eer_node_settle(eer_node_t *node);
+
+/* Stage `node` with `next` props, NULL keeps its props */
+static size_t eer_node_update(eer_node_t *node, void *next)
+{
+    eer_t  *instance = node->instance;
+    uint8_t step     = instance->stage.state.step;
+    size_t  staged   = 0;
+
+    if (EER_STAGE_UNMOUNTED == step) {
+        // Shut from outside, the subtree goes with it
+        for (eer_node_t *child = node->child; child; child = child->sibling)
+            eer_node_shut(child);
+        eer_staging(instance, 0);
+        return 0;
+    }
+
+    // Mount, or finish what apply() or react() left pending
+    if (EER_STAGE_DEFINED == step)
+        eer_staging(instance, next);
+    else if (EER_STAGE_REACTING == step || EER_STAGE_PREPARED == step)
+        eer_staging(instance, 0);
+
+    if (next && EER_STAGE_RELEASED == instance->stage.state.step)
+        eer_staging_update(instance, node->current, next, node->size);
+
+    // Released since the last walk, by the tree or by react() from outside
+    if (!eer_changed_since(instance, &node->version)) {
+        if (node->child)
+            node->skips += 1;
+        return eer_node_settle(node);
+    }
+
+    node->updates += 1;
+    for (eer_node_t *child = node->child; child; child = child->sibling) {
+        if (child->props)
+            child->props(instance, child->next);
+        staged += eer_node_update(child, child->props ? child->next : NULL);
+    }
+
+    return staged + 1;
+}
+
+/*
+ * Below an unchanged node, stage only the children that wait for a stage:
+ * attached since the last walk, left PREPARED or REACTING by apply() or
+ * react(), shut or released from outside. Settled children are passed
+ * through without calling their hooks.
+ */
+static size_t eer_node_settle(eer_node_t *node)
+{
+    size_t staged = 0;
+
+    for (eer_node_t *child = node->child; child; child = child->sibling) {
+        eer_t *instance = child->instance;
+        bool   defined  = EER_STAGE_DEFINED == instance->stage.state.step;
+
+        if (EER_STAGE_RELEASED == instance->stage.state.step
+            && child->version == instance->version) {
+            staged += eer_node_settle(child);
+            continue;
+        }
+        if (defined && child->props)
+            child->props(node->instance, child->next);
+        staged += eer_node_update(child,
+                                  defined && child->props ? child->next : NULL);
+    }
+
+    return staged;
+}
+
+size_t eer_node_staging(eer_node_t *root, void *next_props)
+{
+    return eer_node_update(root, next_props);
+}
+
+void eer_node_shut(eer_node_t *node)
+{
+    for (eer_node_t *child = node->child; child; child = child->sibling)
+        eer_node_shut(child);
+
+    if (eer_node_mounted(node->instance)) {
+        node->instance->stage.state.step = EER_STAGE_UNMOUNTED;
+        eer_staging(node->instance, 0);
+    }
+}
@@ -0,0 +1,45 @@
+#include <eer_rate.h>
+
+bool eer_rate_request(eer_rate_t *rate, uint64_t now)
+{
+    switch (rate->policy) {
+    case EER_RATE_THROTTLE:
+        // Leading edge, then one trailing update per interval
+        if (!rate->started || now - rate->last_us >= rate->interval_us) {
+            rate->started = true;
+            rate->last_us = now;
+            rate->pending = false;
+            return true;
+        }
+        break;
+    case EER_RATE_DEBOUNCE:
+        rate->last_us = now;
+        break;
+    case EER_RATE_SAMPLE:
+        if (!rate->started)
+            rate->last_us = now;
+        break;
+    }
+
+    rate->started = true;
+    rate->pending = true;
+
+    return false;
+}
+
+bool eer_rate_due(eer_rate_t *rate, uint64_t now)
+{
+    uint64_t elapsed = now - rate->last_us;
+
+    if (!rate->pending || elapsed < rate->interval_us)
+        return false;
+
+    rate->pending = false;
+    if (EER_RATE_THROTTLE == rate->policy)
+        rate->last_us = now;
+    else if (EER_RATE_SAMPLE == rate->policy)
+        // Stay on the sampling grid
+        rate->last_us += elapsed - elapsed % rate->interval_us;
+
+    return true;
+}
@@ -0,0 +1,97 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include <eer_realtime.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/* Touch every page of a stack frame of `size` bytes */
+static void __attribute__((noinline)) eer_realtime_touch_stack(size_t size,
+                                                               size_t page)
+{
+    volatile uint8_t frame[size];
+
+    for (size_t offset = 0; offset < size; offset += page)
+        frame[offset] = 0;
+    // Keep the frame alive up to here for the compiler
+    __asm__ volatile("" : : "r"(frame) : "memory");
+}
+
+uint8_t eer_realtime_apply(const eer_loop_attr_t *attr)
+{
+    size_t  page   = (size_t)sysconf(_SC_PAGESIZE);
+    uint8_t failed = 0;
+
+    if (attr->cpus) {
+        cpu_set_t set;
+
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++)
+            if (attr->cpus & (1ull << cpu))
+                CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set))
+            failed |= EER_REALTIME_AFFINITY;
+    }
+
+    if (attr->priority) {
+        struct sched_param parameter = {.sched_priority = attr->priority};
+
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameter))
+            failed |= EER_REALTIME_PRIORITY;
+    }
+
+    if (attr->lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE))
+        failed |= EER_REALTIME_LOCK;
+
+    if (attr->prefault_stack)
+        eer_realtime_touch_stack(attr->prefault_stack, page);
+
+    for (size_t index = 0; index < attr->region_count; index++) {
+        volatile uint8_t *bytes = attr->regions[index].address;
+        size_t            size  = attr->regions[index].size;
+
+        if (!bytes && size) {
+            failed |= EER_REALTIME_PREFAULT;
+            continue;
+        }
+        // Writing the value back forces a private page instead of the zero page
+        for (size_t offset = 0; offset < size; offset += page)
+            bytes[offset] = bytes[offset];
+        if (size)
+            bytes[size - 1] = bytes[size - 1];
+    }
+
+    return failed;
+}
+
+uint64_t eer_realtime_faults(void)
+{
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_THREAD, &usage))
+        return 0;
+
+    return (uint64_t)usage.ru_minflt + (uint64_t)usage.ru_majflt;
+}
+
+#else
+
+uint8_t eer_realtime_apply(const eer_loop_attr_t *attr)
+{
+    return (attr->cpus ? EER_REALTIME_AFFINITY : 0)
+           | (attr->priority ? EER_REALTIME_PRIORITY : 0)
+           | (attr->lock_memory ? EER_REALTIME_LOCK : 0)
+           | (attr->prefault_stack || attr->region_count
+                  ? EER_REALTIME_PREFAULT
+                  : 0);
+}
+
+uint64_t eer_realtime_faults(void) { return 0; }
+
+#endif
@@ -0,0 +1,170 @@
+#include <eer_registry.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define EER_REGISTRY_X86
+#include <immintrin.h>
+#endif
+
+typedef size_t (*eer_registry_scanner)(const uint8_t *stages,
+                                       size_t from, size_t used, uint8_t mask);
+
+/**
+ * @brief Bits of the stage byte that are set for every pending step
+ *
+ * BLOCKED (0) and RELEASED (1) are idle, every step above RELEASED has work
+ * to do, so a stage is pending when its step shares a bit with 0b110.
+ * The mask is computed through the union to stay independent of the
+ * compiler's bit-field layout.
+ */
+static uint8_t eer_registry_pending_mask(void)
+{
+    union eer_stage probe = {.flags = 0};
+
+    probe.state.step = 6;
+
+    return probe.flags;
+}
+
+static size_t eer_registry_scan_scalar(const uint8_t *stages,
+                                       size_t from, size_t used, uint8_t mask)
+{
+    const uint64_t wide = mask * UINT64_C(0x0101010101010101);
+
+    // Skip idle stages a machine word at a time
+    while (from + sizeof(uint64_t) <= used) {
+        uint64_t word;
+
+        memcpy(&word, &stages[from], sizeof(word));
+        if (word & wide)
+            break;
+        from += sizeof(uint64_t);
+    }
+
+    for (; from < used; from++) {
+        if (stages[from] & mask)
+            return from;
+    }
+
+    return used;
+}
+
+#ifdef EER_REGISTRY_X86
+__attribute__((target("sse2"))) static size_t
+eer_registry_scan_sse2(const uint8_t *stages, size_t from, size_t used,
+                       uint8_t mask)
+{
+    const __m128i pending = _mm_set1_epi8((char)mask);
+    const __m128i idle    = _mm_setzero_si128();
+
+    while (from + 16 <= used) {
+        __m128i  block = _mm_loadu_si128((const __m128i *)&stages[from]);
+        unsigned hits  = ~_mm_movemask_epi8(
+                            _mm_cmpeq_epi8(_mm_and_si128(block, pending), idle))
+                       & 0xFFFF;
+
+        if (hits)
+            return from + __builtin_ctz(hits);
+        from += 16;
+    }
+
+    return eer_registry_scan_scalar(stages, from, used, mask);
+}
+
+__attribute__((target("avx2"))) static size_t
+eer_registry_scan_avx2(const uint8_t *stages, size_t from, size_t used,
+                       uint8_t mask)
+{
+    const __m256i pending = _mm256_set1_epi8((char)mask);
+    const __m256i idle    = _mm256_setzero_si256();
+
+    while (from + 32 <= used) {
+        __m256i  block = _mm256_loadu_si256((const __m256i *)&stages[from]);
+        unsigned hits  = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_and_si256(block, pending), idle));
+
+        if (hits)
+            return from + __builtin_ctz(hits);
+        from += 32;
+    }
+
+    return eer_registry_scan_sse2(stages, from, used, mask);
+}
+#endif
+
+/* Resolved by the first scan, a zero mask means not selected yet */
+static eer_registry_scanner eer_registry_scanner_current
+    = eer_registry_scan_scalar;
+static uint8_t eer_registry_mask = 0;
+
+eer_result_t eer_registry_select(enum eer_registry_scan scan)
+{
+    eer_registry_scanner scanner = eer_registry_scan_scalar;
+
+    eer_registry_mask = eer_registry_pending_mask();
+
+#ifdef EER_REGISTRY_X86
+    __builtin_cpu_init();
+    if (EER_REGISTRY_SCAN_AUTO == scan) {
+        if (__builtin_cpu_supports("avx2"))
+            scan = EER_REGISTRY_SCAN_AVX2;
+        else if (__builtin_cpu_supports("sse2"))
+            scan = EER_REGISTRY_SCAN_SSE2;
+    }
+
+    if (EER_REGISTRY_SCAN_AVX2 == scan) {
+        if (!__builtin_cpu_supports("avx2"))
+            return ERROR_UNKNOWN;
+        scanner = eer_registry_scan_avx2;
+    } else if (EER_REGISTRY_SCAN_SSE2 == scan) {
+        if (!__builtin_cpu_supports("sse2"))
+            return ERROR_UNKNOWN;
+        scanner = eer_registry_scan_sse2;
+    }
+#else
+    if (EER_REGISTRY_SCAN_SSE2 == scan || EER_REGISTRY_SCAN_AVX2 == scan)
+        return ERROR_UNKNOWN;
+#endif
+
+    eer_registry_scanner_current = scanner;
+
+    return OK;
+}
+
+eer_result_t eer_registry_add(eer_registry_t *registry, eer_t *instance,
+                              size_t *index)
+{
+    if (registry->used >= registry->size)
+        return ERROR_BUFFER_FULL;
+
+    registry->instances[registry->used] = instance;
+    registry->stages[registry->used]    = instance->stage.flags;
+    instance->mirror                    = &registry->stages[registry->used];
+    if (index)
+        *index = registry->used;
+    registry->used += 1;
+
+    return OK;
+}
+
+size_t eer_registry_next(const eer_registry_t *registry, size_t from)
+{
+    if (!eer_registry_mask)
+        eer_registry_select(EER_REGISTRY_SCAN_AUTO);
+
+    return eer_registry_scanner_current(registry->stages, from, registry->used,
+                                        eer_registry_mask);
+}
+
+enum eer_context eer_registry_staging(eer_registry_t *registry)
+{
+    enum eer_context context = EER_CONTEXT_SAME;
+
+    for (size_t index = eer_registry_next(registry, 0); index < registry->used;
+         index = eer_registry_next(registry, index + 1)) {
+        context |= eer_staging(registry->instances[index],
+                               (void *)EER_CONTEXT_SAME);
+    }
+
+    return context;
+}
@@ -0,0 +1,295 @@
+#include <eer_screen.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#define EER_SCREEN_CELL_BYTES 24 /* Move, colors and glyph of one cell */
+
+static volatile sig_atomic_t eer_screen_resized;
+
+static void eer_screen_winch(int signal)
+{
+    (void)signal;
+    eer_screen_resized = 1;
+}
+
+static const struct eer_cell eer_screen_blank = {' ', 0, 0};
+
+/* Reallocate the buffers for `rows` x `cols`, keeping the drawn cells */
+static eer_result_t eer_screen_resize(eer_screen_t *screen, uint16_t rows,
+                                      uint16_t cols)
+{
+    struct eer_cell *front, *back;
+    char            *output;
+
+    front  = malloc((size_t)rows * cols * sizeof(*front));
+    back   = malloc((size_t)rows * cols * sizeof(*back));
+    output = malloc((size_t)rows * cols * EER_SCREEN_CELL_BYTES + 64);
+    if (!front || !back || !output) {
+        free(front);
+        free(back);
+        free(output);
+        return ERROR_UNKNOWN;
+    }
+
+    for (size_t index = 0; index < (size_t)rows * cols; index++)
+        front[index] = back[index] = eer_screen_blank;
+    for (uint16_t row = 0; row < rows && row < screen->rows; row++)
+        memcpy(&back[(size_t)row * cols], &screen->back[(size_t)row * screen->cols],
+               (cols < screen->cols ? cols : screen->cols) * sizeof(*back));
+
+    free(screen->front);
+    free(screen->back);
+    free(screen->output);
+    screen->front           = front;
+    screen->back            = back;
+    screen->output          = output;
+    screen->output_capacity = (size_t)rows * cols * EER_SCREEN_CELL_BYTES + 64;
+    screen->rows            = rows;
+    screen->cols            = cols;
+    screen->invalid         = true;
+
+    return OK;
+}
+
+/* Resize to the terminal behind the descriptor, 24x80 when it is not one */
+static eer_result_t eer_screen_measure(eer_screen_t *screen)
+{
+    struct winsize size = {0};
+
+    if (ioctl(screen->fd, TIOCGWINSZ, &size) || !size.ws_row || !size.ws_col) {
+        size.ws_row = screen->rows ? screen->rows : 24;
+        size.ws_col = screen->cols ? screen->cols : 80;
+    }
+
+    return eer_screen_resize(screen, size.ws_row, size.ws_col);
+}
+
+eer_result_t eer_screen_init(eer_screen_t *screen, int fd)
+{
+    struct sigaction action = {.sa_handler = eer_screen_winch};
+
+    memset(screen, 0, sizeof(*screen));
+    screen->target = EER_SCREEN_TERMINAL;
+    screen->fd     = fd;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGWINCH, &action, NULL);
+
+    return eer_screen_measure(screen);
+}
+
+eer_result_t eer_screen_headless(eer_screen_t *screen,
+                                 enum eer_screen_target target, uint16_t rows,
+                                 uint16_t cols)
+{
+    memset(screen, 0, sizeof(*screen));
+    screen->target = target;
+    screen->fd     = -1;
+    if (EER_SCREEN_TERMINAL == target || !rows || !cols)
+        return ERROR_UNKNOWN;
+
+    if (EER_SCREEN_NULL == target
+        && (screen->fd = open("/dev/null", O_WRONLY | O_CLOEXEC)) < 0)
+        return ERROR_UNKNOWN;
+
+    return eer_screen_resize(screen, rows, cols);
+}
+
+void eer_screen_release(eer_screen_t *screen)
+{
+    if (EER_SCREEN_NULL == screen->target && screen->fd >= 0)
+        close(screen->fd);
+    screen->fd = -1;
+    free(screen->front);
+    free(screen->back);
+    free(screen->output);
+    screen->front = screen->back = NULL;
+    screen->output               = NULL;
+    screen->rows = screen->cols = 0;
+}
+
+void eer_screen_color(eer_screen_t *screen, enum eer_screen_color fg,
+                      enum eer_screen_color bg)
+{
+    screen->fg = (uint8_t)fg;
+    screen->bg = (uint8_t)bg;
+}
+
+void eer_screen_clear(eer_screen_t *screen)
+{
+    for (size_t index = 0; index < (size_t)screen->rows * screen->cols; index++)
+        screen->back[index] = eer_screen_blank;
+}
+
+void eer_screen_fill(eer_screen_t *screen, int row, int col, int count,
+                     char glyph)
+{
+    struct eer_cell cell = {(uint8_t)glyph, screen->fg, screen->bg};
+
+    if (row < 0 || row >= screen->rows)
+        return;
+    for (; count > 0 && col < screen->cols; col++, count--)
+        if (col >= 0)
+            screen->back[(size_t)row * screen->cols + col] = cell;
+}
+
+size_t eer_screen_print(eer_screen_t *screen, int row, int col,
+                        const char *format, ...)
+{
+    char    text[256];
+    va_list arguments;
+    int     length;
+    size_t  drawn = 0;
+
+    if (row < 0 || row >= screen->rows)
+        return 0;
+
+    va_start(arguments, format);
+    length = vsnprintf(text, sizeof(text), format, arguments);
+    va_end(arguments);
+    if (length > (int)sizeof(text) - 1)
+        length = sizeof(text) - 1;
+
+    for (int index = 0; index < length && col < screen->cols; index++, col++) {
+        if (col < 0)
+            continue;
+        screen->back[(size_t)row * screen->cols + col]
+            = (struct eer_cell){(uint8_t)text[index], screen->fg, screen->bg};
+        drawn++;
+    }
+
+    return drawn;
+}
+
+/* Escape sequence writers, faster than snprintf per cell */
+
+static char *eer_screen_number(char *output, unsigned number)
+{
+    char   digits[10];
+    size_t count = 0;
+
+    do
+        digits[count++] = (char)('0' + number % 10);
+    while ((number /= 10));
+    while (count)
+        *output++ = digits[--count];
+
+    return output;
+}
+
+static char *eer_screen_move(char *output, unsigned row, unsigned col)
+{
+    *output++ = '\033';
+    *output++ = '[';
+    output    = eer_screen_number(output, row + 1);
+    *output++ = ';';
+    output    = eer_screen_number(output, col + 1);
+    *output++ = 'H';
+
+    return output;
+}
+
+static char *eer_screen_pen(char *output, uint8_t fg, uint8_t bg)
+{
+    *output++ = '\033';
+    *output++ = '[';
+    output    = eer_screen_number(output, fg ? fg : 39);
+    *output++ = ';';
+    output    = eer_screen_number(output, bg ? bg + 10 : 49);
+    *output++ = 'm';
+
+    return output;
+}
+
+static size_t eer_screen_write(eer_screen_t *screen, size_t size)
+{
+    size_t written = 0;
+
+    while (written < size) {
+        ssize_t result = write(screen->fd, screen->output + written,
+                               size - written);
+
+        if (result < 0 && EINTR == errno)
+            continue;
+        if (result <= 0)
+            break;
+        written += (size_t)result;
+    }
+
+    return written;
+}
+
+size_t eer_screen_render(eer_screen_t *screen)
+{
+    char    *output;
+    int      cursor_row = -1, cursor_col = -1;
+    int      pen_fg = -1, pen_bg = -1;
+    bool     invalid;
+    size_t   size;
+
+    if (EER_SCREEN_TERMINAL == screen->target && eer_screen_resized) {
+        eer_screen_resized = 0;
+        eer_screen_measure(screen);
+    }
+
+    invalid = screen->invalid;
+    output  = screen->output;
+    if (invalid)
+        output = (char *)memcpy(output, "\033[0m\033[2J", 8) + 8;
+
+    for (int row = 0; row < screen->rows; row++) {
+        size_t first = (size_t)row * screen->cols;
+
+        // Most rows of a frame are unchanged, one compare skips them
+        if (!invalid
+            && !memcmp(&screen->back[first], &screen->front[first],
+                       screen->cols * sizeof(struct eer_cell)))
+            continue;
+
+        for (int col = 0; col < screen->cols; col++) {
+            size_t           index = (size_t)row * screen->cols + col;
+            struct eer_cell *cell  = &screen->back[index];
+
+            if (!invalid && !memcmp(cell, &screen->front[index], sizeof(*cell)))
+                continue;
+            if (invalid && !memcmp(cell, &eer_screen_blank, sizeof(*cell))) {
+                screen->front[index] = *cell; // Cleared by the erase above
+                continue;
+            }
+
+            if (row != cursor_row || col != cursor_col)
+                output = eer_screen_move(output, row, col);
+            if (cell->fg != pen_fg || cell->bg != pen_bg) {
+                output = eer_screen_pen(output, cell->fg, cell->bg);
+                pen_fg = cell->fg;
+                pen_bg = cell->bg;
+            }
+            *output++            = (char)cell->glyph;
+            screen->front[index] = *cell;
+            cursor_row           = row;
+            cursor_col           = col + 1;
+        }
+    }
+    if (pen_fg >= 0)
+        output = (char *)memcpy(output, "\033[0m", 4) + 4;
+
+    screen->invalid = false;
+    size            = (size_t)(output - screen->output);
+    screen->length  = size;
+    if (!size)
+        return 0;
+
+    screen->frames += 1;
+    screen->bytes += EER_SCREEN_MEMORY == screen->target
+                         ? size
+                         : eer_screen_write(screen, size);
+
+    return size;
+}
@@ -0,0 +1,36 @@
+#include <eer_select.h>
+#include <string.h>
+
+const void *eer_selector_get(eer_selector_t *selector)
+{
+    bool changed = !selector->valid;
+
+    for (size_t index = 0; index < selector->count; index++) {
+        struct eer_select_input *input = &selector->inputs[index];
+
+        // Releases that left the field as it was keep the cached value
+        if (!eer_changed_since(input->instance, &input->seen)
+            && selector->valid)
+            continue;
+        if (!selector->valid
+            || memcmp(input->bytes, input->field, input->size)) {
+            memcpy(input->bytes, input->field, input->size);
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        selector->compute(selector->context, selector->value);
+        selector->valid = true;
+        selector->computes += 1;
+    } else {
+        selector->hits += 1;
+    }
+
+    return selector->value;
+}
+
+void eer_selector_invalidate(eer_selector_t *selector)
+{
+    selector->valid = false;
+}
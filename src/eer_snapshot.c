@@ -0,0 +1,188 @@
+#include <eer_snapshot.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define EER_SNAPSHOT_ALIGN 16
+
+#ifndef MAP_POPULATE
+#define MAP_POPULATE 0
+#endif
+
+struct eer_snapshot_header {
+    uint32_t magic;
+    uint16_t format;
+    uint16_t reserved;
+    uint32_t schema;
+    uint32_t count;
+    uint64_t size; /* Whole file */
+};
+
+struct eer_snapshot_record {
+    uint64_t name;
+    uint64_t offset; /* Of the props and state from the start of the file */
+    uint32_t size;
+    uint32_t version;
+};
+
+static uint64_t eer_snapshot_hash(const char *name)
+{
+    uint64_t hash = 0xcbf29ce484222325ull; /* FNV-1a */
+
+    while (*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+static size_t eer_snapshot_align(size_t size)
+{
+    return (size + EER_SNAPSHOT_ALIGN - 1) & ~(size_t)(EER_SNAPSHOT_ALIGN - 1);
+}
+
+/* Offset of the first component's data */
+static size_t eer_snapshot_data(eer_snapshot_t *snapshot)
+{
+    return eer_snapshot_align(sizeof(struct eer_snapshot_header)
+                              + snapshot->count
+                                    * sizeof(struct eer_snapshot_record));
+}
+
+static size_t eer_snapshot_size(eer_snapshot_t *snapshot)
+{
+    size_t size = eer_snapshot_data(snapshot);
+
+    for (size_t index = 0; index < snapshot->count; index++)
+        size += eer_snapshot_align(snapshot->entries[index].size);
+
+    return size;
+}
+
+eer_result_t eer_snapshot_register(eer_snapshot_t *snapshot, eer_t *instance,
+                                   void *data, size_t size, const char *name)
+{
+    if (snapshot->count >= snapshot->capacity)
+        return ERROR_BUFFER_FULL;
+
+    snapshot->entries[snapshot->count++] = (struct eer_snapshot_entry){
+        .instance = instance,
+        .data     = data,
+        .size     = size,
+        .name     = eer_snapshot_hash(name)};
+
+    return OK;
+}
+
+eer_result_t eer_snapshot_save(eer_snapshot_t *snapshot, const char *path)
+{
+    char                        temporary[4096];
+    size_t                      size = eer_snapshot_size(snapshot);
+    uint8_t                    *map;
+    struct eer_snapshot_record *records;
+    int                         fd;
+
+    if (snprintf(temporary, sizeof(temporary), "%s.tmp", path)
+        >= (int)sizeof(temporary))
+        return ERROR_UNKNOWN;
+
+    fd = open(temporary, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return ERROR_UNKNOWN;
+    if (ftruncate(fd, (off_t)size)
+        || MAP_FAILED
+               == (map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                              fd, 0))) {
+        close(fd);
+        unlink(temporary);
+        return ERROR_UNKNOWN;
+    }
+
+    *(struct eer_snapshot_header *)map = (struct eer_snapshot_header){
+        .magic  = EER_SNAPSHOT_MAGIC,
+        .format = EER_SNAPSHOT_FORMAT,
+        .schema = snapshot->schema,
+        .count  = (uint32_t)snapshot->count,
+        .size   = size};
+    records = (struct eer_snapshot_record *)(map
+                                             + sizeof(struct eer_snapshot_header));
+
+    for (size_t index = 0, offset = eer_snapshot_data(snapshot);
+         index < snapshot->count; index++) {
+        struct eer_snapshot_entry *entry = &snapshot->entries[index];
+
+        records[index] = (struct eer_snapshot_record){
+            .name    = entry->name,
+            .offset  = offset,
+            .size    = (uint32_t)entry->size,
+            .version = entry->instance->version};
+        memcpy(map + offset, entry->data, entry->size);
+        offset += eer_snapshot_align(entry->size);
+    }
+
+    // The new file replaces the old one only once it is complete
+    if (msync(map, size, MS_SYNC) | munmap(map, size) | fsync(fd)
+        | close(fd)) {
+        unlink(temporary);
+        return ERROR_UNKNOWN;
+    }
+
+    return rename(temporary, path) ? ERROR_UNKNOWN : OK;
+}
+
+eer_result_t eer_snapshot_restore(eer_snapshot_t *snapshot, const char *path)
+{
+    struct stat                       status;
+    const uint8_t                    *map;
+    const struct eer_snapshot_header *header;
+    const struct eer_snapshot_record *records;
+    size_t                            size;
+    eer_result_t                      result = OK;
+    int                               fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+        return ERROR_UNKNOWN;
+    if (fstat(fd, &status)
+        || (size_t)status.st_size != eer_snapshot_size(snapshot)) {
+        close(fd);
+        return ERROR_UNKNOWN;
+    }
+
+    size = (size_t)status.st_size;
+    map  = mmap(NULL, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map)
+        return ERROR_UNKNOWN;
+
+    header  = (const struct eer_snapshot_header *)map;
+    records = (const struct eer_snapshot_record *)(header + 1);
+    if (EER_SNAPSHOT_MAGIC != header->magic
+        || EER_SNAPSHOT_FORMAT != header->format
+        || snapshot->schema != header->schema
+        || snapshot->count != header->count || size != header->size)
+        result = ERROR_UNKNOWN;
+
+    // Every component must match before the first one is touched
+    for (size_t index = 0; OK == result && index < snapshot->count; index++)
+        if (records[index].name != snapshot->entries[index].name
+            || records[index].size != snapshot->entries[index].size
+            || records[index].offset < eer_snapshot_data(snapshot)
+            || records[index].offset + records[index].size > size)
+            result = ERROR_UNKNOWN;
+
+    for (size_t index = 0; OK == result && index < snapshot->count; index++) {
+        struct eer_snapshot_entry *entry = &snapshot->entries[index];
+
+        memcpy(entry->data, map + records[index].offset, entry->size);
+        entry->instance->version = records[index].version;
+        eer_staging_restore(entry->instance);
+    }
+
+    munmap((void *)map, size);
+
+    return result;
+}
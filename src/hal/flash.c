@@ -0,0 +1,196 @@
+#include <eer_sim.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int                    eer_sim_flash_fd = -1;
+static uint32_t               eer_sim_flash_sector_size;
+static uint16_t               eer_sim_flash_sectors;
+static uint32_t              *eer_sim_flash_erases; /* Per sector */
+static eer_sim_flash_timing_t eer_sim_flash_cost = EER_SIM_FLASH_TIMING;
+static eer_sim_flash_stats_t  eer_sim_flash_counters;
+static uint64_t               eer_sim_flash_budget = UINT64_MAX; /* Bytes */
+
+static bool eer_sim_flash_inside(uint32_t address, size_t size)
+{
+    return eer_sim_flash_fd >= 0
+           && (uint64_t)address + size
+                  <= (uint64_t)eer_sim_flash_sector_size
+                         * eer_sim_flash_sectors;
+}
+
+/* Fill the sector with the erased value */
+static eer_result_t eer_sim_flash_blank(uint16_t sector)
+{
+    uint8_t blank[4096];
+    off_t   start = (off_t)sector * eer_sim_flash_sector_size;
+
+    memset(blank, 0xFF, sizeof(blank));
+    for (uint32_t done = 0; done < eer_sim_flash_sector_size;) {
+        size_t  chunk   = eer_sim_flash_sector_size - done < sizeof(blank)
+                              ? eer_sim_flash_sector_size - done
+                              : sizeof(blank);
+        ssize_t written = pwrite(eer_sim_flash_fd, blank, chunk, start + done);
+
+        if (written <= 0)
+            return ERROR_UNKNOWN;
+        done += (uint32_t)written;
+    }
+
+    return OK;
+}
+
+eer_result_t eer_sim_flash_open(const char *path, uint32_t sector_size,
+                                uint16_t sectors)
+{
+    struct stat status;
+
+    eer_sim_flash_close();
+    if (!sector_size || !sectors)
+        return ERROR_UNKNOWN;
+
+    eer_sim_flash_fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    eer_sim_flash_erases = calloc(sectors, sizeof(*eer_sim_flash_erases));
+    if (eer_sim_flash_fd < 0 || !eer_sim_flash_erases
+        || fstat(eer_sim_flash_fd, &status)) {
+        eer_sim_flash_close();
+        return ERROR_UNKNOWN;
+    }
+
+    eer_sim_flash_sector_size = sector_size;
+    eer_sim_flash_sectors     = sectors;
+    eer_sim_flash_counters    = (eer_sim_flash_stats_t){0};
+    eer_sim_flash_budget      = UINT64_MAX;
+
+    // A new flash comes erased
+    if ((uint64_t)status.st_size != (uint64_t)sector_size * sectors) {
+        if (ftruncate(eer_sim_flash_fd, (off_t)sector_size * sectors)) {
+            eer_sim_flash_close();
+            return ERROR_UNKNOWN;
+        }
+        for (uint16_t sector = 0; sector < sectors; sector++)
+            if (OK != eer_sim_flash_blank(sector)) {
+                eer_sim_flash_close();
+                return ERROR_UNKNOWN;
+            }
+    }
+
+    return OK;
+}
+
+void eer_sim_flash_close(void)
+{
+    if (eer_sim_flash_fd >= 0)
+        close(eer_sim_flash_fd);
+    free(eer_sim_flash_erases);
+
+    eer_sim_flash_fd          = -1;
+    eer_sim_flash_erases      = NULL;
+    eer_sim_flash_sector_size = 0;
+    eer_sim_flash_sectors     = 0;
+}
+
+void eer_sim_flash_timing(eer_sim_flash_timing_t timing)
+{
+    eer_sim_flash_cost = timing;
+}
+
+void eer_sim_flash_stats(eer_sim_flash_stats_t *stats)
+{
+    *stats = eer_sim_flash_counters;
+
+    stats->erase_min = eer_sim_flash_sectors ? UINT32_MAX : 0;
+    stats->erase_max = 0;
+    for (uint16_t sector = 0; sector < eer_sim_flash_sectors; sector++) {
+        if (eer_sim_flash_erases[sector] < stats->erase_min)
+            stats->erase_min = eer_sim_flash_erases[sector];
+        if (eer_sim_flash_erases[sector] > stats->erase_max)
+            stats->erase_max = eer_sim_flash_erases[sector];
+    }
+}
+
+void eer_sim_flash_cut(uint64_t bytes) { eer_sim_flash_budget = bytes; }
+
+static uint32_t eer_sim_flash_sector_size_get(void)
+{
+    return eer_sim_flash_sector_size;
+}
+
+static uint16_t eer_sim_flash_sectors_get(void) { return eer_sim_flash_sectors; }
+
+static eer_result_t eer_sim_flash_read(uint32_t address, void *data,
+                                       size_t size)
+{
+    if (!eer_sim_flash_inside(address, size)
+        || pread(eer_sim_flash_fd, data, size, address) != (ssize_t)size)
+        return ERROR_UNKNOWN;
+
+    eer_sim_flash_counters.reads += 1;
+    eer_sim_flash_counters.read_bytes += size;
+
+    return OK;
+}
+
+static eer_result_t eer_sim_flash_program(uint32_t address, const void *data,
+                                          size_t size)
+{
+    uint8_t        current[256];
+    const uint8_t *bytes = data;
+    size_t         allowed;
+
+    if (!eer_sim_flash_inside(address, size) || !eer_sim_flash_budget)
+        return ERROR_UNKNOWN;
+
+    // Check every bit before the first byte changes
+    for (size_t done = 0; done < size; done += sizeof(current)) {
+        size_t chunk = size - done < sizeof(current) ? size - done
+                                                     : sizeof(current);
+
+        if (pread(eer_sim_flash_fd, current, chunk, address + done)
+            != (ssize_t)chunk)
+            return ERROR_UNKNOWN;
+        for (size_t index = 0; index < chunk; index++)
+            if (bytes[done + index] & ~current[index]) {
+                eer_sim_flash_counters.faults += 1;
+                return ERROR_UNKNOWN;
+            }
+    }
+
+    allowed = size < eer_sim_flash_budget ? size : eer_sim_flash_budget;
+    if (pwrite(eer_sim_flash_fd, data, allowed, address) != (ssize_t)allowed)
+        return ERROR_UNKNOWN;
+
+    if (UINT64_MAX != eer_sim_flash_budget)
+        eer_sim_flash_budget -= allowed;
+    eer_sim_flash_counters.programs += 1;
+    eer_sim_flash_counters.program_bytes += allowed;
+    eer_sim_flash_counters.busy_ns
+        += (uint64_t)eer_sim_flash_cost.program_us * 1000
+           + (uint64_t)eer_sim_flash_cost.program_byte_ns * allowed;
+
+    return allowed == size ? OK : ERROR_UNKNOWN;
+}
+
+static eer_result_t eer_sim_flash_erase(uint16_t sector)
+{
+    if (sector >= eer_sim_flash_sectors || !eer_sim_flash_budget
+        || OK != eer_sim_flash_blank(sector))
+        return ERROR_UNKNOWN;
+
+    eer_sim_flash_erases[sector] += 1;
+    eer_sim_flash_counters.erases += 1;
+    eer_sim_flash_counters.busy_ns
+        += (uint64_t)eer_sim_flash_cost.erase_us * 1000;
+
+    return OK;
+}
+
+eer_flash_handler_t eer_hw_flash = {
+    .sector_size = eer_sim_flash_sector_size_get,
+    .sectors     = eer_sim_flash_sectors_get,
+    .read        = eer_sim_flash_read,
+    .program     = eer_sim_flash_program,
+    .erase       = eer_sim_flash_erase,
+};
@@ -0,0 +1,242 @@
+#include <eer_irq.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#define EER_IRQ_STOP (EER_IRQ_LINES * 2)
+
+struct eer_irq_line {
+    eer_irq_handler_t handler;
+    void             *argument;
+    int               event_fd; /* eer_irq_raise() */
+    int               timer_fd; /* eer_irq_timer() */
+    uint64_t          raised;   /* First pending eer_irq_raise() */
+    uint64_t          expiry;   /* Next timer expiration, atomic */
+    uint64_t          period;   /* Atomic, set by eer_irq_timer() */
+};
+
+static struct eer_irq_line eer_irq_lines[EER_IRQ_LINES];
+static int                 eer_irq_epoll = -1;
+static int                 eer_irq_stop_fd = -1;
+static pthread_t           eer_irq_thread;
+static bool                eer_irq_running;
+static uint64_t            eer_irq_drops;
+
+uint64_t eer_irq_now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+void eer_irq_post(const eer_irq_event_t *event, void *mailbox)
+{
+    if (eer_ring_push(mailbox, event) != OK)
+        __atomic_add_fetch(&eer_irq_drops, 1, __ATOMIC_RELAXED);
+}
+
+uint64_t eer_irq_dropped(void)
+{
+    return __atomic_load_n(&eer_irq_drops, __ATOMIC_RELAXED);
+}
+
+static eer_result_t eer_irq_watch(int fd, uint32_t key)
+{
+    struct epoll_event event = {.events = EPOLLIN, .data.u32 = key};
+
+    return epoll_ctl(eer_irq_epoll, EPOLL_CTL_ADD, fd, &event) ? ERROR_UNKNOWN
+                                                                : OK;
+}
+
+static eer_result_t eer_irq_init(void)
+{
+    if (eer_irq_epoll >= 0)
+        return OK;
+
+    eer_irq_epoll   = epoll_create1(EPOLL_CLOEXEC);
+    eer_irq_stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    for (uint8_t line = 0; line < EER_IRQ_LINES; line++) {
+        eer_irq_lines[line].event_fd = -1;
+        eer_irq_lines[line].timer_fd = -1;
+    }
+
+    if (eer_irq_epoll >= 0 && eer_irq_stop_fd >= 0
+        && eer_irq_watch(eer_irq_stop_fd, EER_IRQ_STOP) == OK)
+        return OK;
+
+    // The next call starts over instead of finding a half-made controller
+    if (eer_irq_epoll >= 0)
+        close(eer_irq_epoll);
+    if (eer_irq_stop_fd >= 0)
+        close(eer_irq_stop_fd);
+    eer_irq_epoll = eer_irq_stop_fd = -1;
+
+    return ERROR_UNKNOWN;
+}
+
+eer_result_t eer_irq_attach(uint8_t line, eer_irq_handler_t handler,
+                            void *argument)
+{
+    if (line >= EER_IRQ_LINES || eer_irq_init() != OK)
+        return ERROR_UNKNOWN;
+    if (eer_irq_lines[line].handler)
+        return ERROR_BUFFER_BUSY;
+
+    struct eer_irq_line *entry = &eer_irq_lines[line];
+
+    entry->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (entry->event_fd < 0)
+        return ERROR_UNKNOWN;
+    entry->argument = argument;
+    entry->handler  = handler;
+
+    return eer_irq_watch(entry->event_fd, line * 2 + 1);
+}
+
+eer_result_t eer_irq_timer(uint8_t line, uint64_t period)
+{
+    if (line >= EER_IRQ_LINES || !eer_irq_lines[line].handler)
+        return ERROR_UNKNOWN;
+
+    struct eer_irq_line *entry = &eer_irq_lines[line];
+
+    if (entry->timer_fd < 0) {
+        entry->timer_fd
+            = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+        if (entry->timer_fd < 0
+            || eer_irq_watch(entry->timer_fd, line * 2) != OK)
+            return ERROR_UNKNOWN;
+    }
+
+    // Absolute expirations let events carry the exact time they were raised
+    uint64_t interval = period * 1000;
+    uint64_t expiry   = eer_irq_now() + interval;
+
+    // The controller thread reads both while dispatching
+    __atomic_store_n(&entry->period, interval, __ATOMIC_RELEASE);
+    __atomic_store_n(&entry->expiry, expiry, __ATOMIC_RELEASE);
+
+    struct itimerspec spec = {
+        .it_interval = {.tv_sec  = interval / 1000000000,
+                        .tv_nsec = interval % 1000000000},
+        .it_value    = {.tv_sec  = expiry / 1000000000,
+                        .tv_nsec = expiry % 1000000000},
+    };
+
+    if (!period)
+        spec.it_value = spec.it_interval;
+
+    return timerfd_settime(entry->timer_fd, TFD_TIMER_ABSTIME, &spec, NULL)
+               ? ERROR_UNKNOWN
+               : OK;
+}
+
+eer_result_t eer_irq_raise(uint8_t line)
+{
+    uint64_t one = 1, none = 0;
+
+    if (line >= EER_IRQ_LINES || !eer_irq_lines[line].handler)
+        return ERROR_UNKNOWN;
+
+    // Coalesced raises report the first one
+    __atomic_compare_exchange_n(&eer_irq_lines[line].raised, &none,
+                                eer_irq_now(), false, __ATOMIC_RELEASE,
+                                __ATOMIC_RELAXED);
+
+    return write(eer_irq_lines[line].event_fd, &one, sizeof(one))
+                   == sizeof(one)
+               ? OK
+               : ERROR_UNKNOWN;
+}
+
+static void eer_irq_dispatch(uint32_t key)
+{
+    struct eer_irq_line *entry = &eer_irq_lines[key / 2];
+    eer_irq_event_t      event = {.line = (uint8_t)(key / 2)};
+    uint64_t             count;
+
+    if (read(key & 1 ? entry->event_fd : entry->timer_fd, &count,
+             sizeof(count))
+        != sizeof(count))
+        return;
+
+    event.count = (uint32_t)count;
+    if (key & 1) {
+        event.raised
+            = __atomic_exchange_n(&entry->raised, 0, __ATOMIC_ACQUIRE);
+        // A raise racing with this read is reported with the next event
+        if (!event.raised)
+            event.raised = eer_irq_now();
+    } else {
+        uint64_t expiry = __atomic_load_n(&entry->expiry, __ATOMIC_ACQUIRE);
+        uint64_t period = __atomic_load_n(&entry->period, __ATOMIC_ACQUIRE);
+
+        // Coalesced expirations report the first one, like raises. A timer
+        // set again meanwhile keeps its new expiration.
+        event.raised = expiry;
+        __atomic_compare_exchange_n(&entry->expiry, &expiry,
+                                    expiry + count * period, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+    }
+
+    entry->handler(&event, entry->argument);
+}
+
+static void *eer_irq_controller(void *argument)
+{
+    struct epoll_event events[EER_IRQ_LINES * 2 + 1];
+
+    for (;;) {
+        int ready = epoll_wait(eer_irq_epoll, events,
+                               sizeof(events) / sizeof(*events), -1);
+
+        for (int index = 0; index < ready; index++) {
+            if (EER_IRQ_STOP == events[index].data.u32)
+                return NULL;
+            eer_irq_dispatch(events[index].data.u32);
+        }
+    }
+}
+
+eer_result_t eer_irq_start(void)
+{
+    if (eer_irq_running)
+        return ERROR_BUFFER_BUSY;
+    if (eer_irq_init() != OK
+        || pthread_create(&eer_irq_thread, NULL, eer_irq_controller, NULL))
+        return ERROR_UNKNOWN;
+    eer_irq_running = true;
+
+    return OK;
+}
+
+void eer_irq_stop(void)
+{
+    uint64_t one = 1;
+
+    if (eer_irq_epoll < 0)
+        return;
+
+    if (eer_irq_running && write(eer_irq_stop_fd, &one, sizeof(one)) > 0)
+        pthread_join(eer_irq_thread, NULL);
+    eer_irq_running = false;
+
+    for (uint8_t line = 0; line < EER_IRQ_LINES; line++) {
+        struct eer_irq_line *entry = &eer_irq_lines[line];
+
+        if (entry->event_fd >= 0)
+            close(entry->event_fd);
+        if (entry->timer_fd >= 0)
+            close(entry->timer_fd);
+        *entry = (struct eer_irq_line){.event_fd = -1, .timer_fd = -1};
+    }
+    close(eer_irq_stop_fd);
+    close(eer_irq_epoll);
+    eer_irq_epoll   = -1;
+    eer_irq_stop_fd = -1;
+}
@@ -0,0 +1,270 @@
+#include <eer_ring.h>
+#include <eer_sim.h>
+#include <time.h>
+
+#define EER_SIM_PORTS 8
+
+static enum eer_sim_clock_mode eer_sim_mode = EER_SIM_REALTIME;
+static uint64_t eer_sim_virtual; /* Virtual time at eer_sim_anchor */
+static uint64_t eer_sim_anchor;  /* CLOCK_MONOTONIC at the last switch */
+static eer_timer_t *eer_sim_timers; /* Armed timers sorted by deadline */
+
+static uint32_t eer_sim_levels[EER_SIM_PORTS];
+
+eer_ring(uint8_t, eer_sim_rx, 1024);
+eer_ring(uint8_t, eer_sim_tx, 1024);
+
+static uint64_t eer_sim_monotonic(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+
+static uint64_t eer_sim_now(void)
+{
+    uint64_t anchor = __atomic_load_n(&eer_sim_anchor, __ATOMIC_ACQUIRE);
+
+    if (EER_SIM_FAST == eer_sim_mode)
+        return eer_sim_virtual;
+    // Loop threads may read the clock first at the same time
+    if (!anchor) {
+        uint64_t now = eer_sim_monotonic();
+
+        if (__atomic_compare_exchange_n(&eer_sim_anchor, &anchor, now, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            anchor = now;
+    }
+
+    return eer_sim_virtual + eer_sim_monotonic() - anchor;
+}
+
+uint64_t eer_now_us(void) { return eer_sim_now(); }
+
+void eer_sim_clock(enum eer_sim_clock_mode mode)
+{
+    eer_sim_virtual = eer_sim_now();
+    __atomic_store_n(&eer_sim_anchor, eer_sim_monotonic(), __ATOMIC_RELEASE);
+    eer_sim_mode = mode;
+}
+
+void eer_sim_advance(uint64_t delay) { eer_sim_virtual += delay; }
+
+/* Timers */
+
+static void eer_sim_timer_stop(eer_timer_t *timer)
+{
+    eer_timer_t **link = &eer_sim_timers;
+
+    while (*link && *link != timer)
+        link = &(*link)->next;
+    if (*link)
+        *link = timer->next;
+    timer->armed = false;
+}
+
+static void eer_sim_timer_insert(eer_timer_t *timer)
+{
+    eer_timer_t **link = &eer_sim_timers;
+
+    while (*link && (*link)->deadline <= timer->deadline)
+        link = &(*link)->next;
+    timer->next  = *link;
+    *link        = timer;
+    timer->armed = true;
+}
+
+static void eer_sim_timer_start(eer_timer_t *timer, uint64_t delay,
+                                uint64_t period, eer_callback_t callback)
+{
+    if (timer->armed)
+        eer_sim_timer_stop(timer);
+
+    timer->deadline = eer_sim_now() + delay;
+    timer->period   = period;
+    timer->callback = callback;
+    eer_sim_timer_insert(timer);
+}
+
+static uint64_t eer_sim_timer_next_deadline(void)
+{
+    return eer_sim_timers ? eer_sim_timers->deadline : UINT64_MAX;
+}
+
+/* Deadline of the last one-shot timer, 0 when only periodic ones are armed */
+static uint64_t eer_sim_timer_last_once(void)
+{
+    uint64_t last = 0;
+
+    for (eer_timer_t *timer = eer_sim_timers; timer; timer = timer->next)
+        if (!timer->period)
+            last = timer->deadline;
+
+    return last;
+}
+
+/* Fire timers up to `limit`, fast mode moves time to each deadline */
+static size_t eer_sim_timer_fire(uint64_t limit)
+{
+    size_t fired = 0;
+
+    while (eer_sim_timers && eer_sim_timers->deadline <= limit) {
+        eer_timer_t *timer = eer_sim_timers;
+
+        eer_sim_timers = timer->next;
+        timer->armed   = false;
+        if (EER_SIM_FAST == eer_sim_mode && timer->deadline > eer_sim_virtual)
+            eer_sim_virtual = timer->deadline;
+        if (timer->period) {
+            timer->deadline += timer->period;
+            eer_sim_timer_insert(timer);
+        }
+
+        timer->callback.method(timer->callback.argument, timer);
+        fired++;
+    }
+
+    return fired;
+}
+
+static size_t eer_sim_timer_poll(void) { return eer_sim_timer_fire(eer_sim_now()); }
+
+static void eer_sim_timer_sleep_until(uint64_t deadline)
+{
+    // Nothing would ever wake the program up
+    if (UINT64_MAX == deadline && !eer_sim_timers)
+        return;
+
+    if (EER_SIM_FAST == eer_sim_mode) {
+        // Periodic timers would fire forever, wait for one-shot ones only
+        if (UINT64_MAX == deadline && !(deadline = eer_sim_timer_last_once()))
+            return;
+        eer_sim_timer_fire(deadline);
+        if (deadline > eer_sim_virtual)
+            eer_sim_virtual = deadline;
+        return;
+    }
+
+    for (uint64_t now = eer_sim_now(); now < deadline; now = eer_sim_now()) {
+        uint64_t wake = eer_sim_timer_next_deadline();
+
+        if (wake > deadline)
+            wake = deadline;
+        if (wake > now) {
+#ifdef __linux__
+            // Absolute wake-ups do not drift with the time spent here
+            uint64_t        monotonic = wake - eer_sim_virtual + eer_sim_anchor;
+            struct timespec target    = {.tv_sec  = monotonic / 1000000,
+                                         .tv_nsec = monotonic % 1000000 * 1000};
+
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, NULL);
+#else
+            struct timespec delay = {.tv_sec  = (wake - now) / 1000000,
+                                     .tv_nsec = (wake - now) % 1000000 * 1000};
+
+            nanosleep(&delay, NULL);
+#endif
+        }
+        eer_sim_timer_poll();
+    }
+}
+
+static void eer_sim_timer_spin_until(uint64_t deadline)
+{
+    if (EER_SIM_FAST == eer_sim_mode) {
+        eer_sim_timer_sleep_until(deadline);
+        return;
+    }
+
+    while (eer_sim_now() < deadline)
+        ;
+    eer_sim_timer_poll();
+}
+
+/* GPIO */
+
+#define eer_sim_pin_mask(pin) (1u << ((pin)->number & 31))
+#define eer_sim_pin_port(pin) eer_sim_levels[(pin)->port % EER_SIM_PORTS]
+
+static void eer_sim_gpio_mode(eer_pin_t *pin, enum eer_pin_mode mode)
+{
+    if (EER_PIN_INPUT_PULLUP == mode)
+        eer_sim_pin_port(pin) |= eer_sim_pin_mask(pin);
+}
+
+bool eer_sim_gpio_level(eer_pin_t *pin)
+{
+    return eer_sim_pin_port(pin) & eer_sim_pin_mask(pin);
+}
+
+static void eer_sim_gpio_set(eer_pin_t *pin)
+{
+    eer_sim_pin_port(pin) |= eer_sim_pin_mask(pin);
+}
+
+static void eer_sim_gpio_clear(eer_pin_t *pin)
+{
+    eer_sim_pin_port(pin) &= ~eer_sim_pin_mask(pin);
+}
+
+static void eer_sim_gpio_toggle(eer_pin_t *pin)
+{
+    eer_sim_pin_port(pin) ^= eer_sim_pin_mask(pin);
+}
+
+void eer_sim_gpio_drive(eer_pin_t *pin, bool level)
+{
+    if (level)
+        eer_sim_gpio_set(pin);
+    else
+        eer_sim_gpio_clear(pin);
+}
+
+/* UART */
+
+static eer_result_t eer_sim_uart_write(const uint8_t *data, size_t size)
+{
+    return eer_ring_push_batch(&eer_sim_tx, data, size) == size
+               ? OK
+               : ERROR_BUFFER_FULL;
+}
+
+static size_t eer_sim_uart_read(uint8_t *data, size_t size)
+{
+    return eer_ring_pop_batch(&eer_sim_rx, data, size);
+}
+
+size_t eer_sim_uart_receive(const uint8_t *data, size_t size)
+{
+    return eer_ring_push_batch(&eer_sim_rx, data, size);
+}
+
+size_t eer_sim_uart_transmitted(uint8_t *data, size_t size)
+{
+    return eer_ring_pop_batch(&eer_sim_tx, data, size);
+}
+
+eer_gpio_handler_t eer_hw_gpio = {
+    .mode   = eer_sim_gpio_mode,
+    .get    = eer_sim_gpio_level,
+    .set    = eer_sim_gpio_set,
+    .clear  = eer_sim_gpio_clear,
+    .toggle = eer_sim_gpio_toggle,
+};
+
+eer_uart_handler_t eer_hw_uart = {
+    .write = eer_sim_uart_write,
+    .read  = eer_sim_uart_read,
+};
+
+eer_timer_handler_t eer_hw_timer = {
+    .now           = eer_sim_now,
+    .sleep_until   = eer_sim_timer_sleep_until,
+    .spin_until    = eer_sim_timer_spin_until,
+    .start         = eer_sim_timer_start,
+    .stop          = eer_sim_timer_stop,
+    .poll          = eer_sim_timer_poll,
+    .next_deadline = eer_sim_timer_next_deadline,
+};
@@ -0,0 +1,204 @@
+/**
+ * Async I/O Test
+ *
+ * This test writes and reads back a file through an I/O context and streams
+ * a pipe into a component with eer_io_receive(), once with io_uring and once
+ * with the epoll fallback. It checks the data, that a pipe read completes
+ * only after the writer thread fills it, and that io_uring submits a batch
+ * of requests with a single syscall.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include "test.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BLOCKS 32
+#define BLOCK_SIZE 4096
+#define MESSAGES 10
+
+typedef struct {
+  eer_io_t *io;
+  eer_io_request_t *request;
+} Reader_props_t;
+
+typedef struct {
+  int messages;
+  bool ordered;
+} Reader_state_t;
+
+eer_header(Reader);
+
+WILL_MOUNT(Reader) { state->ordered = true; }
+SHOULD_UPDATE_SKIP(Reader);
+WILL_UPDATE_SKIP(Reader);
+
+RELEASE(Reader) {
+  eer_io_request_t *request = props->request;
+
+  if (!request->done)
+    return;
+  state->ordered &= request->result == 1 &&
+                    ((uint8_t *)request->buffer)[0] == state->messages;
+  state->messages++;
+  request->done = false;
+  eer_io_submit(props->io, request);
+}
+
+DID_MOUNT_SKIP(Reader);
+DID_UPDATE_SKIP(Reader);
+DID_UNMOUNT_SKIP(Reader);
+
+struct run {
+  enum eer_io_backend backend;
+  bool file_matches;
+  uint64_t write_syscalls;
+  int messages;
+  bool ordered;
+  bool waited;
+};
+
+eer_loop_t io_loop;
+eer_idle_t idle = EER_IDLE();
+eer_io_t io;
+int pipe_fds[2];
+volatile int reading = 0; // Runs that wait for the pipe
+
+uint8_t written[BLOCKS][BLOCK_SIZE];
+uint8_t read_back[BLOCKS][BLOCK_SIZE];
+eer_io_request_t writes[BLOCKS];
+eer_io_request_t reads[BLOCKS];
+uint8_t message;
+eer_io_request_t pipe_read;
+
+Reader_t reader;
+
+void run(enum eer_io_backend backend, struct run *result) {
+  char path[] = "/tmp/eer_io_XXXXXX";
+  int file = mkstemp(path);
+  int completed = 0;
+  bool receiving = false;
+
+  unlink(path);
+  pipe(pipe_fds);
+  eer_io_init(&io, 64, backend);
+  result->backend = io.backend;
+
+  for (int block = 0; block < BLOCKS; block++) {
+    memset(written[block], block + 1, BLOCK_SIZE);
+    writes[block] = (eer_io_request_t){.op = EER_IO_WRITE,
+                                       .fd = file,
+                                       .buffer = written[block],
+                                       .size = BLOCK_SIZE,
+                                       .offset = block * BLOCK_SIZE};
+    reads[block] = (eer_io_request_t){.op = EER_IO_READ,
+                                      .fd = file,
+                                      .buffer = read_back[block],
+                                      .size = BLOCK_SIZE,
+                                      .offset = block * BLOCK_SIZE};
+  }
+  pipe_read = (eer_io_request_t){
+      .op = EER_IO_READ, .fd = pipe_fds[0], .buffer = &message, .size = 1,
+      .offset = -1};
+  reader = (Reader_t){
+      .instance = eer_define_component(Reader, reader),
+      .props = {.io = &io, .request = &pipe_read}};
+
+  eer_idle_init(&idle);
+  eer_loop_init(&io_loop, NULL);
+  eer_loop_idle(&io_loop, &idle);
+  eer_loop_io(&io_loop, &io);
+
+  for (int block = 0; block < BLOCKS; block++)
+    eer_io_submit(&io, &writes[block]);
+
+  loop_on(&io_loop) {
+    // Writes, then reads, then the pipe
+    if (completed < BLOCKS) {
+      completed = 0;
+      for (int block = 0; block < BLOCKS; block++)
+        completed += writes[block].done && writes[block].result == BLOCK_SIZE;
+      if (completed == BLOCKS) {
+        result->write_syscalls = io.syscalls;
+        for (int block = 0; block < BLOCKS; block++)
+          eer_io_submit(&io, &reads[block]);
+      }
+    } else if (completed < 2 * BLOCKS) {
+      completed = BLOCKS;
+      for (int block = 0; block < BLOCKS; block++)
+        completed += reads[block].done;
+      if (completed == 2 * BLOCKS) {
+        result->file_matches = !memcmp(written, read_back, sizeof(written));
+        eer_io_submit(&io, &pipe_read);
+        reading++;
+      }
+    } else {
+      // The writer sleeps before filling the pipe, the first reap found it
+      // empty
+      if (!receiving)
+        result->waited = !pipe_read.done;
+      receiving = true;
+      eer_io_receive(Reader, reader, pipe_read);
+      exit_when(reader.state.messages == MESSAGES);
+    }
+  }
+
+  result->messages = reader.state.messages;
+  result->ordered = reader.state.ordered;
+  eer_io_release(&io);
+  eer_idle_release(&idle);
+  close(file);
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+}
+
+struct run runs[2];
+bool done = false;
+
+test(test_async_io) {
+  run(EER_IO_URING, &runs[0]);
+  run(EER_IO_EPOLL, &runs[1]);
+  done = true;
+}
+
+void feed(int expected) {
+  while (reading != expected)
+    usleep(100);
+  usleep(5000);
+  for (uint8_t index = 0; index < MESSAGES; index++) {
+    write(pipe_fds[1], &index, 1);
+    usleep(1000);
+  }
+}
+
+result_t test_async_io() {
+  feed(1);
+  feed(2);
+  while (!done)
+    usleep(1000);
+
+  for (int index = 0; index < 2; index++) {
+    struct run *run = &runs[index];
+    const char *name = run->backend == EER_IO_URING ? "io_uring" : "epoll";
+
+    log_info("%s: %llu syscalls for %d writes", name,
+             (unsigned long long)run->write_syscalls, BLOCKS);
+    test_assert(run->file_matches, "%s: file should read back as written",
+                name);
+    test_assert(run->waited, "%s: pipe read should wait for data", name);
+    test_assert(run->messages == MESSAGES && run->ordered,
+                "%s: every pipe message should arrive in order, got %d",
+                name, run->messages);
+  }
+  test_assert(runs[1].backend == EER_IO_EPOLL,
+              "The epoll backend should be used when forced");
+  test_assert(runs[0].backend != EER_IO_URING || runs[0].write_syscalls <= 2,
+              "io_uring should submit a batch with one syscall, used %llu",
+              (unsigned long long)runs[0].write_syscalls);
+
+  return OK;
+}
@@ -0,0 +1,129 @@
+/**
+ * Batch Apply Test
+ *
+ * This test verifies that apply_batch prepares every accepted component in
+ * the same iteration and releases them together in the next one, with
+ * components of different types in one batch.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include "test.h"
+#include <stdio.h>
+
+#define CHANNELS 4
+
+typedef struct {
+  int level;
+} ChannelComponent_props_t;
+
+typedef struct {
+  int level;
+  int update_count;
+} ChannelComponent_state_t;
+
+eer_header(ChannelComponent);
+
+WILL_MOUNT(ChannelComponent) { state->level = props->level; }
+
+// Negative levels are rejected
+SHOULD_UPDATE(ChannelComponent) { return next_props->level >= 0; }
+
+WILL_UPDATE_SKIP(ChannelComponent);
+
+RELEASE(ChannelComponent) {
+  state->level = props->level;
+  state->update_count++;
+}
+
+DID_MOUNT_SKIP(ChannelComponent);
+DID_UPDATE_SKIP(ChannelComponent);
+DID_UNMOUNT_SKIP(ChannelComponent);
+
+typedef struct {
+  int frame;
+} FrameComponent_props_t;
+
+typedef struct {
+  int frame;
+} FrameComponent_state_t;
+
+eer_header(FrameComponent);
+
+WILL_MOUNT_SKIP(FrameComponent);
+SHOULD_UPDATE_SKIP(FrameComponent);
+
+UPDATE(FrameComponent) { state->frame = props->frame; }
+
+DID_MOUNT_SKIP(FrameComponent);
+DID_UNMOUNT_SKIP(FrameComponent);
+
+ChannelComponent_t channels[CHANNELS];
+eer_withprops(FrameComponent, frameComponent, _({.frame = 0}));
+
+int released_together = 0;
+int prepared_together = 0;
+
+void after_prepare(void *data) {
+  for (int index = 0; index < CHANNELS; index++)
+    if (EER_STAGE_PREPARED == channels[index].instance.stage.state.step)
+      prepared_together++;
+}
+
+void after_release(void *data) {
+  for (int index = 0; index < CHANNELS; index++)
+    if (channels[index].state.update_count == 2)
+      released_together++;
+}
+
+test(test_batch_apply) {
+  for (int index = 0; index < CHANNELS; index++)
+    channels[index] = (ChannelComponent_t){
+        .instance = eer_define_component(ChannelComponent, channel)};
+
+  test_hook_after_iteration(2, after_prepare, NULL);
+  test_hook_after_iteration(3, after_release, NULL);
+
+  loop() {
+    // Iteration 0 mounts, iteration 1 prepares, iteration 2 releases
+    int level = (int)eer_current_iteration * 10;
+    struct eer_batch batch[] = {
+        eer_batch_item(ChannelComponent, channels[0], _({.level = level})),
+        eer_batch_item(ChannelComponent, channels[1], _({.level = level + 1})),
+        eer_batch_item(ChannelComponent, channels[2], _({.level = -1})),
+        eer_batch_item(ChannelComponent, channels[3], _({.level = level + 3})),
+        eer_batch_item(FrameComponent, frameComponent,
+                       _({.frame = (int)eer_current_iteration})),
+    };
+
+    if (eer_current_iteration <= 2) {
+      apply_batch(batch, sizeof(batch) / sizeof(*batch));
+    }
+    if (eer_current_iteration >= 2) {
+      eer_land.state.unmounted = true;
+    }
+  }
+}
+
+result_t test_batch_apply() {
+  test_wait_for_iteration(3);
+
+  test_assert(prepared_together == CHANNELS - 1,
+              "Accepted channels should be prepared together, got %d",
+              prepared_together);
+  test_assert(released_together == CHANNELS - 1,
+              "Accepted channels should be released together, got %d",
+              released_together);
+  test_assert(channels[2].state.update_count == 1,
+              "Rejected channel should only mount, got %d updates",
+              channels[2].state.update_count);
+  test_assert(channels[3].state.level == 13,
+              "Channel 3 should hold the props of iteration 1, got %d",
+              channels[3].state.level);
+  test_assert(frameComponent.state.frame == 1,
+              "Fused component in the batch should update, got frame %d",
+              frameComponent.state.frame);
+
+  return OK;
+}
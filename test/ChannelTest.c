@@ -0,0 +1,134 @@
+/**
+ * Channel Test
+ *
+ * This test pipelines samples from an acquisition loop to a processing loop
+ * on another thread through a channel. It checks that every sample arrives
+ * in order through typed send and receive functions, that full and empty
+ * channels report their error codes and that the receiving component is
+ * staged only when the channel has data.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include "test.h"
+#include <sched.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define SAMPLES 20000
+
+eer_channel(int, samples, 64);
+eer_channel_typed(int, sample);
+
+typedef struct {
+  eer_channel_t *input;
+} Accumulator_props_t;
+
+typedef struct {
+  long sum;
+  int received;
+  int idle_updates;
+  bool ordered;
+} Accumulator_state_t;
+
+eer_header(Accumulator);
+
+WILL_MOUNT(Accumulator) { state->ordered = true; }
+SHOULD_UPDATE_SKIP(Accumulator);
+WILL_UPDATE_SKIP(Accumulator);
+
+RELEASE(Accumulator) {
+  int items[16];
+  size_t count;
+
+  // Only the mount may find the channel empty
+  if (!eer_channel_count(props->input))
+    state->idle_updates++;
+  while ((count = sample_receive_batch(props->input, items, 16))) {
+    for (size_t index = 0; index < count; index++) {
+      state->ordered &= items[index] == state->received;
+      state->sum += items[index];
+      state->received++;
+    }
+  }
+}
+
+DID_MOUNT_SKIP(Accumulator);
+DID_UPDATE_SKIP(Accumulator);
+DID_UNMOUNT_SKIP(Accumulator);
+
+eer_withprops(Accumulator, accumulator, _({.input = &samples}));
+
+eer_loop_t acquisition;
+eer_loop_t processing;
+bool codes_checked = false;
+
+void *acquisition_thread(void *argument) {
+  int next = 0;
+
+  eer_loop_init(&acquisition, NULL);
+  loop_on(&acquisition) {
+    // Burst of up to 32 samples per iteration
+    int burst[32];
+    size_t count = 0;
+
+    while (count < 32 && next + (int)count < SAMPLES) {
+      burst[count] = next + (int)count;
+      count++;
+    }
+    size_t sent = sample_send_batch(&samples, burst, count);
+
+    // Full channel, let the processing loop drain it
+    if (!sent)
+      sched_yield();
+    next += (int)sent;
+    exit_when(next == SAMPLES);
+  }
+
+  return NULL;
+}
+
+test(test_channel_pipeline) {
+  eer_channel(int, probe, 2);
+  int item = 1;
+
+  codes_checked = eer_channel_receive(&probe, &item) == ERROR_BUFFER_EMPTY &&
+                  eer_channel_send(&probe, &item) == OK &&
+                  eer_channel_send(&probe, &item) == OK &&
+                  eer_channel_send(&probe, &item) == ERROR_BUFFER_FULL &&
+                  eer_channel_count(&probe) == 2;
+
+  pthread_t thread;
+
+  pthread_create(&thread, NULL, acquisition_thread, NULL);
+
+  eer_loop_init(&processing, NULL);
+  loop_on(&processing) {
+    if (!eer_channel_count(&samples))
+      sched_yield();
+    receive(Accumulator, accumulator, samples);
+    exit_when(accumulator.state.received == SAMPLES);
+  }
+
+  pthread_join(thread, NULL);
+}
+
+result_t test_channel_pipeline() {
+  while (eer_loop_iteration(&processing) == 0 ||
+         accumulator.state.received < SAMPLES)
+    usleep(1000);
+
+  test_assert(codes_checked,
+              "Channel should report ERROR_BUFFER_FULL and ERROR_BUFFER_EMPTY");
+  test_assert(accumulator.state.ordered, "Samples should arrive in order");
+  test_assert(accumulator.state.sum == (long)SAMPLES * (SAMPLES - 1) / 2,
+              "Every sample should arrive once, sum %ld",
+              accumulator.state.sum);
+  test_assert(accumulator.state.idle_updates <= 1,
+              "Receiver should update only when the channel has data, "
+              "%d idle updates in %d iterations",
+              accumulator.state.idle_updates, (int)processing.iteration);
+
+  return OK;
+}
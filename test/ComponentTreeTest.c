@@ -0,0 +1,171 @@
+/**
+ * Component Tree Test
+ *
+ * This test builds a tree of a panel, two groups fed by the panel's state
+ * and three leaves fed by the first group. It checks that the first pass
+ * mounts the whole tree, that unchanged props skip the tree, that a parent
+ * whose should_update refuses the props skips its subtree, that only the
+ * branches whose derived props changed update, that a skipped subtree
+ * still mounts a child attached late and releases a child left prepared by
+ * apply(), and that shut unmounts children before their parent.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_node.h>
+#include "test.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define LEAVES 3
+
+typedef struct {
+  int value;
+} Node_props_t;
+
+typedef struct {
+  int value;
+  int releases;
+} Node_state_t;
+
+eer_header(Node);
+
+int unmount_order[2 + 2 + LEAVES + 1];
+int unmounts = 0;
+
+WILL_MOUNT_SKIP(Node);
+SHOULD_UPDATE(Node) { return next_props->value >= 0; }
+WILL_UPDATE_SKIP(Node);
+RELEASE(Node) {
+  state->value = props->value;
+  state->releases++;
+}
+DID_MOUNT_SKIP(Node);
+DID_UPDATE_SKIP(Node);
+DID_UNMOUNT(Node) { unmount_order[unmounts++] = props->value; }
+
+void tens(eer_t *parent, void *props) {
+  *(Node_props_t *)props =
+      (Node_props_t){.value = ((Node_t *)parent)->state.value / 10};
+}
+
+void parity(eer_t *parent, void *props) {
+  *(Node_props_t *)props =
+      (Node_props_t){.value = ((Node_t *)parent)->state.value % 2};
+}
+
+void square(eer_t *parent, void *props) {
+  int value = ((Node_t *)parent)->state.value;
+
+  *(Node_props_t *)props = (Node_props_t){.value = value * value};
+}
+
+eer_withprops(Node, panel, _({0}));
+eer_withprops(Node, group, _({0}));
+eer_withprops(Node, flag, _({0}));
+eer_withprops(Node, late, _({0}));
+Node_t leaves[LEAVES];
+
+eer_node(Node, panel, NULL);
+eer_node(Node, group, tens);
+eer_node(Node, flag, parity);
+eer_node(Node, late, square);
+eer_node_t leaf_nodes[LEAVES];
+
+#define STEPS 7
+
+int inputs[STEPS] = {0, 0, 1, -5, 21, 21, 21};
+size_t staged[STEPS];
+int releases[STEPS][4];
+int panel_values[STEPS];
+int late_steps[STEPS];
+int prepared_steps[STEPS];
+int recorded = 0;
+
+void record(void *data) {
+  int step = recorded++;
+
+  releases[step][0] = panel.state.releases;
+  releases[step][1] = group.state.releases;
+  releases[step][2] = flag.state.releases;
+  releases[step][3] = leaves[LEAVES - 1].state.releases;
+  panel_values[step] = panel.state.value;
+  late_steps[step] = late.instance.stage.state.step;
+  prepared_steps[step] = leaves[1].instance.stage.state.step;
+}
+
+test(test_component_tree) {
+  eer_node_attach(&panel_node, &group_node);
+  eer_node_attach(&panel_node, &flag_node);
+  for (int index = 0; index < LEAVES; index++) {
+    leaves[index] =
+        (Node_t){.instance = eer_define_component(Node, leaf)};
+    leaf_nodes[index] = (eer_node_t){.instance = &leaves[index].instance,
+                                     .props = square,
+                                     .current = &leaves[index].props,
+                                     .next = &(Node_props_t){0},
+                                     .size = sizeof(Node_props_t)};
+    eer_node_attach(&group_node, &leaf_nodes[index]);
+  }
+  for (int step = 1; step <= STEPS; step++)
+    test_hook_after_iteration(step, record, NULL);
+
+  loop() {
+    int step = (int)eer_current_iteration;
+
+    // 0 mounts the tree, 1 keeps the props, 2 changes the parity branch,
+    // 3 is refused by the panel and 4 changes the tens branch
+    if (5 == step)
+      eer_node_attach(&flag_node, &late_node);
+
+    staged[step] =
+        eer_node_staging(&panel_node, &(Node_props_t){.value = inputs[step]});
+
+    // Released by the next walk, although the group does not change
+    if (5 == step)
+      apply(Node, leaves[1], _({.value = 50}));
+
+    if (STEPS - 1 == step) {
+      eer_node_shut(&panel_node);
+      eer_land.state.unmounted = true;
+    }
+  }
+}
+
+result_t test_component_tree() {
+  test_wait_for_iteration(STEPS);
+
+  test_assert(staged[0] == 3 + LEAVES && releases[0][3] == 1,
+              "The first pass should mount the tree, %zu staged", staged[0]);
+  test_assert(staged[1] == 0 && releases[1][0] == 1 &&
+                  panel_node.skips >= 1,
+              "Unchanged props should skip the tree, %zu staged", staged[1]);
+  test_assert(staged[2] == 2 && releases[2][2] == 2 && releases[2][1] == 1 &&
+                  releases[2][3] == 1 && group_node.skips == 1,
+              "Only the changed branch should update, %zu staged", staged[2]);
+  test_assert(staged[3] == 0 && releases[3][0] == 2 && panel_values[3] == 1,
+              "A refusing parent should skip its subtree, %zu staged",
+              staged[3]);
+  test_assert(staged[4] == 2 + LEAVES && releases[4][1] == 2 &&
+                  releases[4][2] == 2 && leaves[0].state.value == 4,
+              "The tens branch should update with its leaves, %zu staged",
+              staged[4]);
+  test_assert(staged[5] == 1 && late_steps[5] == EER_STAGE_RELEASED &&
+                  late.state.value == 1,
+              "A child attached late should mount in a skipped subtree, %zu "
+              "staged",
+              staged[5]);
+  test_assert(prepared_steps[5] == EER_STAGE_PREPARED && staged[6] == 1 &&
+                  leaves[1].state.value == 50,
+              "A prepared child should release in a skipped subtree, %zu "
+              "staged",
+              staged[6]);
+  test_assert(unmounts == 3 + LEAVES + 1 && unmount_order[0] == 4 &&
+                  unmount_order[unmounts - 1] == 21,
+              "Shut should unmount children before their parent, %d "
+              "unmounted",
+              unmounts);
+
+  return OK;
+}
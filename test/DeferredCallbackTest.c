@@ -0,0 +1,124 @@
+/**
+ * Deferred Callback Test
+ *
+ * This test queues callbacks on a loop from a component's DID_UPDATE and
+ * from another thread. It checks that they run on the loop thread, never
+ * inside the lifecycle hook that queued them, at most `budget` per
+ * iteration, and that none is lost.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include "test.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define BUDGET 4
+#define REMOTE_CALLBACKS 1000
+
+eer_mpmc(eer_callback_t, deferred, 256);
+eer_loop_t worker;
+
+pthread_t worker_thread;
+int executed = 0;
+int executed_remote = 0;
+int max_per_iteration = 0;
+int current_iteration_count = 0;
+bool in_lifecycle = false;
+bool ran_in_lifecycle = false;
+bool ran_off_thread = false;
+int local_queued = 0;
+
+eer_result_t side_effect(void *argument, void *trigger) {
+  ran_in_lifecycle |= in_lifecycle;
+  ran_off_thread |= !pthread_equal(pthread_self(), worker_thread) ||
+                    trigger != &worker;
+  current_iteration_count++;
+  executed++;
+  executed_remote += *(int *)argument;
+
+  return OK;
+}
+
+eer_result_t count_iteration(void *argument, void *trigger) {
+  if (current_iteration_count > max_per_iteration)
+    max_per_iteration = current_iteration_count;
+  current_iteration_count = 0;
+
+  return OK;
+}
+
+int local = 0, remote = 1;
+
+typedef struct {
+  int value;
+} Notifier_props_t;
+
+typedef struct {
+  int value;
+} Notifier_state_t;
+
+eer_header(Notifier);
+
+WILL_MOUNT_SKIP(Notifier);
+SHOULD_UPDATE_SKIP(Notifier);
+WILL_UPDATE_SKIP(Notifier);
+RELEASE(Notifier) { state->value = props->value; }
+DID_MOUNT_SKIP(Notifier);
+
+DID_UPDATE(Notifier) {
+  in_lifecycle = true;
+  // Slow side effects leave the critical path
+  for (int index = 0; index < 3; index++)
+    if (eer_loop_defer(&worker, (eer_callback_t){side_effect, &local}) == OK)
+      local_queued++;
+  in_lifecycle = false;
+}
+
+DID_UNMOUNT_SKIP(Notifier);
+
+eer_withprops(Notifier, notifier, _({.value = 0}));
+
+test(test_deferred_callbacks) {
+  worker_thread = pthread_self();
+  eer_loop_init(&worker, NULL);
+  eer_loop_callbacks(&worker, &deferred, BUDGET);
+  eer_loop_hook(&worker, EER_LOOP_ON_ITERATION,
+                (eer_callback_t){count_iteration, NULL});
+
+  loop_on(&worker) {
+    int value = (int)worker.iteration;
+
+    if (value < 50)
+      react(Notifier, notifier, _({.value = value}));
+    exit_when(executed == local_queued + REMOTE_CALLBACKS);
+  }
+}
+
+result_t test_deferred_callbacks() {
+  while (eer_loop_iteration(&worker) == 0)
+    usleep(100);
+
+  for (int index = 0; index < REMOTE_CALLBACKS; index++)
+    while (eer_loop_defer(&worker, (eer_callback_t){side_effect, &remote}) ==
+           ERROR_BUFFER_FULL)
+      usleep(10);
+
+  while (executed < local_queued + REMOTE_CALLBACKS)
+    usleep(1000);
+
+  test_assert(executed_remote == REMOTE_CALLBACKS,
+              "Every callback from another thread should run, got %d",
+              executed_remote);
+  test_assert(local_queued > 0 && executed - executed_remote == local_queued,
+              "Every callback from DID_UPDATE should run, %d of %d",
+              executed - executed_remote, local_queued);
+  test_assert(!ran_in_lifecycle, "Callbacks should not run inside hooks");
+  test_assert(!ran_off_thread, "Callbacks should run on the loop thread");
+  test_assert(max_per_iteration <= BUDGET,
+              "At most %d callbacks should run per iteration, got %d", BUDGET,
+              max_per_iteration);
+
+  return OK;
+}
@@ -0,0 +1,156 @@
+/**
+ * FD Input Test
+ *
+ * This test writes chunks into a pipe from another thread while a loop
+ * reads it through an FdInput. It checks that every byte arrives in order,
+ * that the descriptor is read only after epoll reported it, so a quiet pipe
+ * costs no reads, and that closing the writer marks the input closed.
+ * While the collector holds off, a full ring should pause the input instead
+ * of waking the loop on every iteration.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_fd.h>
+#include "test.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define CHUNKS 200
+#define CHUNK_SIZE 100
+
+eer_loop_t fd_loop;
+eer_idle_t idle = EER_IDLE(.timeout_us = 0);
+int pipe_fds[2];
+
+eer_fd(input, 0, &fd_loop, 1024);
+
+typedef struct {
+  eer_ring_t *input;
+} Collector_props_t;
+
+typedef struct {
+  uint64_t received;
+  bool ordered;
+} Collector_state_t;
+
+eer_header(Collector);
+
+WILL_MOUNT(Collector) { state->ordered = true; }
+SHOULD_UPDATE_SKIP(Collector);
+WILL_UPDATE_SKIP(Collector);
+
+RELEASE(Collector) {
+  uint8_t bytes[256];
+  size_t count;
+
+  while ((count = eer_ring_pop_batch(props->input, bytes, sizeof(bytes)))) {
+    for (size_t index = 0; index < count; index++)
+      state->ordered &= bytes[index] == (uint8_t)(state->received + index);
+    state->received += count;
+  }
+}
+
+DID_MOUNT_SKIP(Collector);
+DID_UPDATE_SKIP(Collector);
+DID_UNMOUNT_SKIP(Collector);
+
+eer_withprops(Collector, collector, _({.input = &input_bytes}));
+
+bool ready = false;
+bool held = false;
+bool done = false;
+
+test(test_fd_input) {
+  pipe(pipe_fds);
+  input.props.fd = pipe_fds[0];
+
+  eer_idle_init(&idle);
+  eer_loop_init(&fd_loop, NULL);
+  eer_loop_idle(&fd_loop, &idle);
+  loop_on(&fd_loop) {
+    eer_fd_receive(input);
+    if (!held)
+      receive(Collector, collector, input_bytes);
+    ready = true;
+    exit_when(input.state.closed && !eer_ring_count(&input_bytes));
+  }
+
+  eer_idle_release(&idle);
+  close(pipe_fds[0]);
+  done = true;
+}
+
+result_t test_fd_input() {
+  uint8_t chunk[CHUNK_SIZE];
+  uint64_t sent = 0;
+
+  while (!ready)
+    usleep(100);
+
+  for (int index = 0; index < CHUNKS; index++) {
+    for (int offset = 0; offset < CHUNK_SIZE; offset++)
+      chunk[offset] = (uint8_t)(sent + offset);
+    write(pipe_fds[1], chunk, CHUNK_SIZE);
+    sent += CHUNK_SIZE;
+    if (index % 20 == 0)
+      usleep(1000);
+  }
+  while (collector.state.received < sent)
+    usleep(1000);
+
+  uint64_t reads = input.state.reads;
+  uint64_t iterations = eer_loop_iteration(&fd_loop);
+
+  usleep(50000);
+  uint64_t quiet_reads = input.state.reads - reads;
+  uint64_t quiet_iterations = eer_loop_iteration(&fd_loop) - iterations;
+
+  // Twice the ring, the second half waits in the pipe
+  held = true;
+  for (int index = 0; index < 2048 / CHUNK_SIZE; index++) {
+    for (int offset = 0; offset < CHUNK_SIZE; offset++)
+      chunk[offset] = (uint8_t)(sent + offset);
+    write(pipe_fds[1], chunk, CHUNK_SIZE);
+    sent += CHUNK_SIZE;
+  }
+  usleep(20000);
+  iterations = eer_loop_iteration(&fd_loop);
+  usleep(50000);
+  uint64_t held_iterations = eer_loop_iteration(&fd_loop) - iterations;
+  bool paused = input.state.paused;
+
+  held = false;
+  eer_loop_wake(&fd_loop);
+  while (collector.state.received < sent)
+    usleep(1000);
+
+  close(pipe_fds[1]);
+  while (!done)
+    usleep(1000);
+
+  log_info("%llu bytes in %llu reads",
+           (unsigned long long)input.state.received,
+           (unsigned long long)input.state.reads);
+
+  test_assert(input.state.watched == false && input.state.closed,
+              "Closing the writer should close the input");
+  test_assert(collector.state.received == sent && collector.state.ordered,
+              "Every byte should arrive in order, got %llu of %llu",
+              (unsigned long long)collector.state.received,
+              (unsigned long long)sent);
+  test_assert(quiet_reads == 0 && quiet_iterations <= 1,
+              "A quiet pipe should cost no reads, %llu reads in %llu "
+              "iterations",
+              (unsigned long long)quiet_reads,
+              (unsigned long long)quiet_iterations);
+  test_assert(paused && held_iterations == 0,
+              "A full ring should pause the input, %llu iterations",
+              (unsigned long long)held_iterations);
+  test_assert(input.state.reads <= CHUNKS + 2 + 2048 / CHUNK_SIZE,
+              "Reads should batch the ready bytes, %llu reads",
+              (unsigned long long)input.state.reads);
+
+  return OK;
+}
@@ -0,0 +1,80 @@
+/**
+ * Fused Update Test
+ *
+ * This test verifies that components defined with UPDATE(Type) go through
+ * the same apply and react cycles as components with separate hooks, using
+ * the single fused entry once mounted.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include "test.h"
+#include <stdio.h>
+
+typedef struct {
+  int value;
+} FusedComponent_props_t;
+
+typedef struct {
+  int value;
+  int update_count;
+} FusedComponent_state_t;
+
+eer_header(FusedComponent);
+
+WILL_MOUNT(FusedComponent) { state->update_count = 0; }
+
+SHOULD_UPDATE(FusedComponent) { return props->value != next_props->value; }
+
+UPDATE(FusedComponent) {
+  state->value = props->value;
+  state->update_count++;
+  log_info("FusedComponent updated to %d (update #%d)", state->value,
+           state->update_count);
+}
+
+DID_MOUNT_SKIP(FusedComponent);
+DID_UNMOUNT_SKIP(FusedComponent);
+
+eer_withprops(FusedComponent, fusedComponent, _({.value = 1}));
+
+bool fused_installed = false;
+
+void after_mount_fused(void *data) {
+  *(bool *)data = fusedComponent.instance.update == FusedComponent_update;
+}
+
+test(test_fused_update) {
+  test_hook_after_iteration(1, after_mount_fused, &fused_installed);
+
+  loop() {
+    // Iteration 0 mounts, iterations 1 and 2 run the two-phase apply
+    if (eer_current_iteration <= 2) {
+      apply(FusedComponent, fusedComponent,
+            _({.value = eer_current_iteration ? 2 : 1}));
+    }
+
+    // Iteration 3: react runs the fused hook at once
+    if (eer_current_iteration == 3) {
+      react(FusedComponent, fusedComponent, _({.value = 5}));
+    }
+
+    if (eer_current_iteration >= 3) {
+      eer_land.state.unmounted = true;
+    }
+  }
+}
+
+result_t test_fused_update() {
+  test_wait_for_iteration(4);
+
+  test_assert(fused_installed, "Mounting should install the fused update");
+  test_assert(fusedComponent.state.update_count == 3,
+              "Component should update on mount, apply and react, got %d",
+              fusedComponent.state.update_count);
+  test_assert(fusedComponent.state.value == 5,
+              "Final value should be 5, got %d", fusedComponent.state.value);
+
+  return OK;
+}
@@ -0,0 +1,89 @@
+/**
+ * Idle Apply Test
+ *
+ * This test applies new props to a component of a loop that idles with a
+ * long timeout and nobody to wake it. It checks that the loop does not wait
+ * between the iteration that prepares the component and the one that
+ * releases it.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include "test.h"
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TIMEOUT_US 500000
+
+typedef struct {
+  int value;
+} Setting_props_t;
+
+typedef struct {
+  int value;
+} Setting_state_t;
+
+eer_header(Setting);
+
+WILL_MOUNT_SKIP(Setting);
+SHOULD_UPDATE_SKIP(Setting);
+WILL_UPDATE_SKIP(Setting);
+RELEASE(Setting) { state->value = props->value; }
+DID_MOUNT_SKIP(Setting);
+DID_UPDATE_SKIP(Setting);
+DID_UNMOUNT_SKIP(Setting);
+
+eer_withprops(Setting, setting, _({.value = 1}));
+
+eer_loop_t apply_loop;
+eer_idle_t idle = EER_IDLE(.timeout_us = TIMEOUT_US);
+uint64_t applied_us = 0;
+uint64_t released_us = 0;
+bool done = false;
+
+uint64_t now_us() {
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return now.tv_sec * 1000000ull + now.tv_nsec / 1000;
+}
+
+test(test_idle_apply) {
+  int iteration = 0;
+
+  eer_idle_init(&idle);
+  eer_loop_init(&apply_loop, NULL);
+  eer_loop_idle(&apply_loop, &idle);
+  loop_on(&apply_loop) {
+    // Mount first, then prepare new props once
+    apply(Setting, setting, _({.value = iteration ? 7 : 1}));
+    if (1 == iteration)
+      applied_us = now_us();
+    if (7 == setting.state.value) {
+      released_us = now_us();
+      exit_when(true);
+    }
+    iteration++;
+  }
+
+  eer_idle_release(&idle);
+  done = true;
+}
+
+result_t test_idle_apply() {
+  while (!done)
+    usleep(1000);
+
+  test_assert(applied_us && released_us,
+              "Applied props should be released, value %d",
+              setting.state.value);
+  test_assert(released_us - applied_us < TIMEOUT_US / 2,
+              "A prepared component should release without idling, took "
+              "%llu us",
+              (unsigned long long)(released_us - applied_us));
+
+  return OK;
+}
@@ -0,0 +1,134 @@
+/**
+ * Idle Loop Test
+ *
+ * This test feeds a loop from another thread first with sparse messages,
+ * then with a dense burst, then leaves it quiet. It checks that every
+ * message arrives, that sparse messages wake the loop from the blocking
+ * phase, that the burst opens the adaptive spin and yield windows and that
+ * a quiet loop blocks instead of iterating.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include "test.h"
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SPARSE 20
+#define BURST 2000
+
+eer_channel(int, messages, 64);
+
+typedef struct {
+  eer_channel_t *input;
+} Inbox_props_t;
+
+typedef struct {
+  int received;
+} Inbox_state_t;
+
+eer_header(Inbox);
+
+WILL_MOUNT_SKIP(Inbox);
+SHOULD_UPDATE_SKIP(Inbox);
+WILL_UPDATE_SKIP(Inbox);
+
+RELEASE(Inbox) {
+  int message;
+
+  while (eer_channel_receive(props->input, &message) == OK)
+    state->received++;
+}
+
+DID_MOUNT_SKIP(Inbox);
+DID_UPDATE_SKIP(Inbox);
+DID_UNMOUNT_SKIP(Inbox);
+
+eer_withprops(Inbox, inbox, _({.input = &messages}));
+
+eer_loop_t idle_loop;
+eer_idle_t idle = EER_IDLE(.adaptive = true, .spin_max_us = 200);
+bool ready = false;
+bool done = false;
+
+test(test_idle_loop) {
+  eer_idle_init(&idle);
+  eer_loop_init(&idle_loop, NULL);
+  eer_loop_idle(&idle_loop, &idle);
+  ready = true;
+  loop_on(&idle_loop) { receive(Inbox, inbox, messages); }
+
+  eer_idle_release(&idle);
+  done = true;
+}
+
+void send(int message) {
+  while (eer_channel_send(&messages, &message) != OK)
+    ;
+  eer_loop_wake(&idle_loop);
+}
+
+void pause_us(uint64_t delay) {
+  struct timespec now;
+  uint64_t until;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  until = now.tv_sec * 1000000ull + now.tv_nsec / 1000 + delay;
+  do
+    clock_gettime(CLOCK_MONOTONIC, &now);
+  while (now.tv_sec * 1000000ull + now.tv_nsec / 1000 < until);
+}
+
+result_t test_idle_loop() {
+  while (!ready)
+    usleep(100);
+
+  for (int index = 0; index < SPARSE; index++) {
+    send(index);
+    usleep(5000);
+  }
+  uint64_t block_wakes = idle.counters[EER_IDLE_BLOCK].wakes;
+
+  for (int index = 0; index < BURST; index++) {
+    send(index);
+    pause_us(20);
+  }
+  uint32_t spin = idle.spin_us;
+  uint32_t yield = idle.yield_us;
+
+  usleep(10000);
+  uint64_t before = eer_loop_iteration(&idle_loop);
+
+  usleep(100000);
+  uint64_t quiet = eer_loop_iteration(&idle_loop) - before;
+
+  eer_loop_stop(&idle_loop);
+  while (!done)
+    usleep(1000);
+
+  log_info("Burst windows: spin %u us, yield %u us", spin, yield);
+  for (int phase = 0; phase < EER_IDLE_PHASES; phase++)
+    log_info("%s: %llu wakes, %llu us",
+             (const char *[]){"spin", "yield", "block"}[phase],
+             (unsigned long long)idle.counters[phase].wakes,
+             (unsigned long long)idle.counters[phase].time_ns / 1000);
+
+  test_assert(inbox.state.received == SPARSE + BURST,
+              "Every message should arrive, got %d", inbox.state.received);
+  test_assert(block_wakes >= SPARSE / 2,
+              "Sparse messages should wake a blocked loop, got %llu",
+              (unsigned long long)block_wakes);
+  test_assert(spin + yield > 0 && (!spin || !idle.uniprocessor),
+              "A dense burst should open the idle windows, spin %u us yield "
+              "%u us",
+              spin, yield);
+  test_assert(quiet <= 2, "A quiet loop should block, iterated %llu times",
+              (unsigned long long)quiet);
+  test_assert(idle.counters[EER_IDLE_BLOCK].time_ns > 100000000,
+              "The quiet period should be spent blocking, got %llu us",
+              (unsigned long long)idle.counters[EER_IDLE_BLOCK].time_ns / 1000);
+
+  return OK;
+}
@@ -0,0 +1,135 @@
+/**
+ * IRQ Latency Test
+ *
+ * This test raises a timer IRQ every millisecond and a signal-driven IRQ
+ * from SIGUSR1. Handlers only post into mailboxes, and components react to
+ * the mailboxes through receive(). The test checks that every raise reaches
+ * the component and that the latency from IRQ to did_update is recorded.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_irq.h>
+#include "test.h"
+#include <signal.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define TIMER_LINE 0
+#define SIGNAL_LINE 1
+#define SIGNALS 20
+
+eer_ring(eer_irq_event_t, timer_mailbox, 64);
+eer_ring(eer_irq_event_t, signal_mailbox, 64);
+
+eer_histogram_t latency = {0};
+
+typedef struct {
+  eer_ring_t *mailbox;
+} IrqCounter_props_t;
+
+typedef struct {
+  uint32_t raises;
+  eer_irq_event_t last;
+  bool handled;
+} IrqCounter_state_t;
+
+eer_header(IrqCounter);
+
+WILL_MOUNT_SKIP(IrqCounter);
+SHOULD_UPDATE_SKIP(IrqCounter);
+WILL_UPDATE_SKIP(IrqCounter);
+
+RELEASE(IrqCounter) {
+  eer_irq_event_t event;
+
+  state->handled = false;
+  while (eer_ring_pop(props->mailbox, &event) == OK) {
+    state->raises += event.count;
+    state->last = event;
+    state->handled = true;
+  }
+}
+
+DID_MOUNT_SKIP(IrqCounter);
+
+DID_UPDATE(IrqCounter) {
+  if (state->handled)
+    eer_histogram_add(&latency, eer_irq_latency(&state->last));
+}
+
+DID_UNMOUNT_SKIP(IrqCounter);
+
+eer_withprops(IrqCounter, ticks, _({.mailbox = &timer_mailbox}));
+eer_withprops(IrqCounter, signals, _({.mailbox = &signal_mailbox}));
+
+eer_loop_t irq_loop;
+bool attached = false;
+bool stopped = false;
+
+void on_signal(int number) { eer_irq_raise(SIGNAL_LINE); }
+
+void wait_for_signals(uint32_t count) {
+  for (int wait = 0; wait < 1000; wait++) {
+    if (__atomic_load_n(&signals.state.raises, __ATOMIC_ACQUIRE) >= count)
+      return;
+    usleep(1000);
+  }
+}
+
+test(test_irq_latency) {
+  attached = eer_irq_attach(TIMER_LINE, eer_irq_post, &timer_mailbox) == OK &&
+             eer_irq_attach(SIGNAL_LINE, eer_irq_post, &signal_mailbox) ==
+                 OK &&
+             eer_irq_attach(SIGNAL_LINE, eer_irq_post, &signal_mailbox) ==
+                 ERROR_BUFFER_BUSY &&
+             eer_irq_timer(TIMER_LINE, 1000) == OK && eer_irq_start() == OK;
+
+  eer_loop_init(&irq_loop, NULL);
+  loop_on(&irq_loop) {
+    receive(IrqCounter, ticks, timer_mailbox);
+    receive(IrqCounter, signals, signal_mailbox);
+  }
+
+  eer_irq_stop();
+  stopped = true;
+}
+
+result_t test_irq_latency() {
+  struct sigaction action = {.sa_handler = on_signal};
+
+  sigaction(SIGUSR1, &action, NULL);
+  while (eer_loop_iteration(&irq_loop) == 0)
+    usleep(100);
+
+  // Pending SIGUSR1 merge, send the next one once the last was received
+  for (uint32_t index = 0; index < SIGNALS; index++) {
+    kill(getpid(), SIGUSR1);
+    wait_for_signals(index + 1);
+  }
+  usleep(100000);
+  eer_loop_stop(&irq_loop);
+  while (!stopped)
+    usleep(1000);
+
+  eer_histogram_report(&latency, "irq to did_update ns", stdout);
+
+  test_assert(attached, "IRQ lines should attach once and start");
+  test_assert(ticks.state.raises >= 100,
+              "Timer IRQ should raise every millisecond, got %u",
+              ticks.state.raises);
+  test_assert(signals.state.raises == SIGNALS,
+              "Every signal should raise the IRQ, got %u",
+              signals.state.raises);
+  test_assert(eer_irq_dropped() == 0, "No event should be dropped");
+  test_assert(latency.count > 0 && latency.count <= ticks.state.raises +
+                                                        signals.state.raises,
+              "Latency should be recorded per handled event, got %llu",
+              (unsigned long long)latency.count);
+  test_assert(eer_histogram_percentile(&latency, 50) < 100000000,
+              "Median IRQ latency should stay below 100 ms, got %llu ns",
+              (unsigned long long)eer_histogram_percentile(&latency, 50));
+
+  return OK;
+}
@@ -0,0 +1,158 @@
+/**
+ * Journal Test
+ *
+ * This test persists a metering component to a file-backed simulated
+ * flash after each of its updates. It checks that the journal writes a
+ * fraction of what rewriting the component would, that erases spread
+ * evenly over the sectors, that a power cut in the middle of a commit
+ * restores the last complete commit, and that the restored component
+ * counts as changed and carries on without mounting again.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_journal.h>
+#include <eer_sim.h>
+#include "test.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SECTOR 1024
+#define SECTORS 8
+#define COMMITS 2000
+
+typedef struct {
+  int channel;
+} Meter_props_t;
+
+typedef struct {
+  uint32_t ticks;
+  int16_t samples[64];
+  char label[32];
+  uint8_t mode;
+} Meter_state_t;
+
+eer_header(Meter);
+
+int mounts = 0;
+
+WILL_MOUNT(Meter) {
+  snprintf(state->label, sizeof(state->label), "channel %d", props->channel);
+  mounts++;
+}
+SHOULD_UPDATE_SKIP(Meter);
+WILL_UPDATE_SKIP(Meter);
+RELEASE(Meter) {
+  state->ticks++;
+  state->samples[state->ticks % 64] = (int16_t)(state->ticks * 3);
+  state->mode = state->ticks / 100 % 4;
+}
+DID_MOUNT_SKIP(Meter);
+DID_UPDATE_SKIP(Meter);
+DID_UNMOUNT_SKIP(Meter);
+
+eer_withprops(Meter, meter, _({.channel = 1}));
+
+eer_journal(store, 2, 256);
+eer_journal(restart, 2, 256);
+
+Meter_t saved;
+eer_sim_flash_stats_t wear;
+eer_result_t cold = OK;
+eer_result_t cut = OK;
+eer_result_t warm = ERROR_UNKNOWN;
+eer_result_t resumed = ERROR_UNKNOWN;
+int failures = 0;
+uint64_t worst_ns = 0;
+bool restored = false;
+
+test(test_journal) {
+  char path[] = "/tmp/eer-flash-XXXXXX";
+  eer_sim_flash_stats_t before, after;
+
+  close(mkstemp(path));
+  eer_sim_flash_open(path, SECTOR, SECTORS);
+
+  eer_journal_add(&store, Meter, meter);
+  cold = eer_journal_open(&store, 0, SECTORS);
+
+  for (int commit = 0; commit < COMMITS; commit++) {
+    react(Meter, meter, _({.channel = 1}));
+
+    eer_sim_flash_stats(&before);
+    failures += OK != eer_journal_commit(&store);
+    eer_sim_flash_stats(&after);
+    if (after.busy_ns - before.busy_ns > worst_ns)
+      worst_ns = after.busy_ns - before.busy_ns;
+  }
+  eer_sim_flash_stats(&wear);
+  saved = meter;
+
+  // The power goes away in the middle of the next commit
+  react(Meter, meter, _({.channel = 1}));
+  eer_sim_flash_cut(6);
+  cut = eer_journal_commit(&store);
+
+  // Start again with the same flash and an empty component
+  eer_sim_flash_open(path, SECTOR, SECTORS);
+  memset(&meter.props, 0, sizeof(meter.props) + sizeof(meter.state));
+  meter.instance.stage.state.step = EER_STAGE_DEFINED;
+  meter.instance.version = 0;
+
+  eer_journal_add(&restart, Meter, meter);
+  warm = eer_journal_open(&restart, 0, SECTORS);
+  restored = !memcmp(&meter.props, &saved.props,
+                     sizeof(meter.props) + sizeof(meter.state)) &&
+             EER_STAGE_RELEASED == meter.instance.stage.state.step &&
+             eer_version(meter) != 0;
+
+  react(Meter, meter, _({.channel = 1}));
+  resumed = eer_journal_commit(&restart);
+
+  eer_sim_flash_close();
+  unlink(path);
+
+  loop() { eer_land.state.unmounted = true; }
+}
+
+result_t test_journal() {
+  uint64_t rewrite = (uint64_t)COMMITS * (sizeof(meter.props) +
+                                          sizeof(meter.state));
+
+  test_wait_for_iteration(1);
+
+  log_info("%llu bytes programmed for %llu changed bytes, %llu to rewrite "
+           "the component",
+           (unsigned long long)wear.program_bytes,
+           (unsigned long long)store.changed, (unsigned long long)rewrite);
+  log_info("%llu compactions, %u to %u erases per sector",
+           (unsigned long long)store.compactions, wear.erase_min,
+           wear.erase_max);
+  log_info("%llu us flash time per commit, %llu us at worst",
+           (unsigned long long)(wear.busy_ns / COMMITS / 1000),
+           (unsigned long long)(worst_ns / 1000));
+
+  test_assert(OK != cold && failures == 0,
+              "An empty flash should hold no state and every commit should "
+              "succeed, %d failed",
+              failures);
+  test_assert(wear.program_bytes * 4 < rewrite,
+              "The journal should program under a quarter of full rewrites, "
+              "%llu of %llu bytes",
+              (unsigned long long)wear.program_bytes,
+              (unsigned long long)rewrite);
+  test_assert(wear.erases >= SECTORS && wear.erase_max - wear.erase_min <= 1,
+              "Erases should spread evenly over the sectors, %u to %u",
+              wear.erase_min, wear.erase_max);
+  test_assert(OK != cut && OK == warm && restored && mounts == 1,
+              "A cut commit should restore the last complete one without "
+              "mounting");
+  test_assert(OK == resumed && meter.state.ticks == saved.state.ticks + 1,
+              "The restored component should keep updating, %u ticks",
+              meter.state.ticks);
+
+  return OK;
+}
@@ -0,0 +1,186 @@
+/**
+ * Keyed Children Test
+ *
+ * This test reconciles a collection of 1000 keyed children against edited
+ * key lists. It checks that inserting, removing, moving and relabeling
+ * single items runs the lifecycle of those items only, that moving the
+ * first key to the end is reported as one move, that the children follow
+ * the new order and that a repeated key is rejected without touching the
+ * collection.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_keyed.h>
+#include "test.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define ITEMS 1000
+
+// Compared byte by byte, no padding
+typedef struct {
+  uint64_t key;
+  int64_t label;
+} Item_props_t;
+
+typedef struct {
+  uint64_t key;
+} Item_state_t;
+
+eer_header(Item);
+
+int mounted = 0;
+int unmounted = 0;
+int updated = 0;
+
+WILL_MOUNT(Item) { mounted++; }
+SHOULD_UPDATE_SKIP(Item);
+WILL_UPDATE_SKIP(Item);
+RELEASE(Item) { state->key = props->key; }
+DID_MOUNT_SKIP(Item);
+DID_UPDATE(Item) { updated++; }
+DID_UNMOUNT(Item) { unmounted++; }
+
+int labels[ITEMS * 2];
+
+void item_props(void *context, size_t index, uint64_t key, void *props) {
+  (void)context;
+  (void)index;
+  *(Item_props_t *)props = (Item_props_t){.key = key, .label = labels[key]};
+}
+
+eer_keyed(Item, items, ITEMS + 1, item_props, NULL);
+
+uint64_t keys[ITEMS + 1];
+size_t count = ITEMS;
+
+struct step {
+  int mounted, unmounted, updated;
+  uint64_t moves;
+  bool ordered;
+} steps[6];
+eer_result_t duplicate_result;
+size_t duplicate_count;
+
+/* The children follow the keys and show their own key */
+bool ordered() {
+  if (items.count != count)
+    return false;
+  for (size_t position = 0; position < count; position++) {
+    Item_t *item = (Item_t *)eer_keyed_child(&items, position);
+
+    if (eer_keyed_key(&items, position) != keys[position] ||
+        item->state.key != keys[position])
+      return false;
+  }
+
+  return true;
+}
+
+int recorded = 0;
+
+void record(void *data) {
+  steps[recorded++] =
+      (struct step){mounted, unmounted, updated, items.moves, ordered()};
+  mounted = unmounted = updated = 0;
+  items.moves = 0;
+}
+
+void remove_at(size_t position) {
+  memmove(&keys[position], &keys[position + 1],
+          (count - position - 1) * sizeof(*keys));
+  count--;
+}
+
+void insert_at(size_t position, uint64_t key) {
+  memmove(&keys[position + 1], &keys[position],
+          (count - position) * sizeof(*keys));
+  keys[position] = key;
+  count++;
+}
+
+test(test_keyed_children) {
+  for (size_t index = 0; index < ITEMS; index++)
+    keys[index] = index;
+  for (int step = 1; step <= 6; step++)
+    test_hook_after_iteration(step, record, NULL);
+
+  loop() {
+    uint64_t first, saved;
+
+    switch (eer_current_iteration) {
+    case 1:
+      // Insert one key in the middle
+      insert_at(500, ITEMS + 7);
+      break;
+    case 2:
+      // Remove one key
+      remove_at(10);
+      break;
+    case 3:
+      // Move the first key to the end, only that key moves
+      first = keys[0];
+      remove_at(0);
+      keys[count++] = first;
+      break;
+    case 4:
+      // Relabel one key
+      labels[keys[300]] = 1;
+      break;
+    case 5:
+      // Repeated keys leave the collection as it is
+      saved = keys[1];
+      keys[1] = keys[2];
+      duplicate_result = eer_keyed_reconcile(&items, keys, count);
+      keys[1] = saved;
+      duplicate_count = items.count;
+      continue;
+    case 6:
+      eer_keyed_shut(&items);
+      eer_land.state.unmounted = true;
+      continue;
+    }
+
+    eer_keyed_reconcile(&items, keys, count);
+  }
+}
+
+result_t test_keyed_children() {
+  test_wait_for_iteration(7);
+
+  test_assert(steps[0].mounted == ITEMS && steps[0].ordered,
+              "The first reconcile should mount every key, %d mounts",
+              steps[0].mounted);
+  test_assert(steps[1].mounted == 1 && steps[1].unmounted == 0 &&
+                  steps[1].updated == 0 && steps[1].moves == 0 &&
+                  steps[1].ordered,
+              "An insert should mount one child only, %d mounts %d updates "
+              "%llu moves",
+              steps[1].mounted, steps[1].updated,
+              (unsigned long long)steps[1].moves);
+  test_assert(steps[2].unmounted == 1 && steps[2].mounted == 0 &&
+                  steps[2].updated == 0 && steps[2].moves == 0 &&
+                  steps[2].ordered,
+              "A removal should unmount one child only, %d unmounts",
+              steps[2].unmounted);
+  test_assert(steps[3].moves == 1 && steps[3].mounted == 0 &&
+                  steps[3].unmounted == 0 && steps[3].updated == 0 &&
+                  steps[3].ordered,
+              "Moving one key should report one move, %llu moves",
+              (unsigned long long)steps[3].moves);
+  test_assert(steps[4].updated == 1 && steps[4].mounted == 0 &&
+                  steps[4].moves == 0 && steps[4].ordered,
+              "Changed props should update one child, %d updates",
+              steps[4].updated);
+  test_assert(duplicate_result == ERROR_UNKNOWN &&
+                  duplicate_count == ITEMS && steps[5].mounted == 0 &&
+                  steps[5].unmounted == 0 && steps[5].ordered,
+              "A repeated key should be rejected");
+  test_assert(unmounted == ITEMS && items.count == 0,
+              "Shut should unmount every child, %d unmounted", unmounted);
+
+  return OK;
+}
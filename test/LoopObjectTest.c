@@ -0,0 +1,124 @@
+/**
+ * Loop Object Test
+ *
+ * This test runs two eer_loop_t objects in two threads at once, each with
+ * its own component and registry, and checks that their iteration counters,
+ * hooks and stop requests do not interfere. A second loop in the same
+ * function checks that loop objects need no goto label.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include "test.h"
+#include <stdio.h>
+#include <unistd.h>
+
+typedef struct {
+  int value;
+} LoopCounter_props_t;
+
+typedef struct {
+  int value;
+  int update_count;
+} LoopCounter_state_t;
+
+eer_header(LoopCounter);
+
+WILL_MOUNT(LoopCounter) { state->update_count = 0; }
+SHOULD_UPDATE_SKIP(LoopCounter);
+WILL_UPDATE_SKIP(LoopCounter);
+
+RELEASE(LoopCounter) {
+  state->value = props->value;
+  state->update_count++;
+}
+
+DID_MOUNT_SKIP(LoopCounter);
+DID_UPDATE_SKIP(LoopCounter);
+DID_UNMOUNT_SKIP(LoopCounter);
+
+eer_withprops(LoopCounter, counter0, _({.value = 0}));
+eer_withprops(LoopCounter, counter1, _({.value = 0}));
+
+eer_registry(core0_components, 4);
+eer_registry(core1_components, 4);
+
+eer_loop_t core0;
+eer_loop_t core1;
+
+int exits[2] = {0, 0};
+int local_iterations = 0;
+
+eer_result_t count_exit(void *argument, void *trigger) {
+  eer_loop_t *loop = trigger;
+
+  exits[loop == &core1] += *(int *)argument;
+
+  return OK;
+}
+
+int one = 1;
+
+void run_core(eer_loop_t *loop, eer_registry_t *registry, LoopCounter_t *counter) {
+  eer_loop_init(loop, registry);
+  eer_registry_add(registry, &counter->instance, NULL);
+  eer_loop_hook(loop, EER_LOOP_ON_EXIT, (eer_callback_t){count_exit, &one});
+
+  loop_on(loop) {
+    LoopCounter_t *self = counter;
+    int value = (int)loop->iteration;
+
+    apply(LoopCounter, (*self), _({.value = value}));
+  }
+}
+
+void *core1_thread(void *argument) {
+  run_core(&core1, &core1_components, &counter1);
+
+  return NULL;
+}
+
+test(test_loop_objects) {
+  pthread_t thread;
+  eer_loop_t local;
+
+  pthread_create(&thread, NULL, core1_thread, NULL);
+  run_core(&core0, &core0_components, &counter0);
+  pthread_join(thread, NULL);
+
+  // Second loop in the same function
+  eer_loop_init(&local, NULL);
+  loop_on(&local) { exit_when(++local_iterations == 3); }
+}
+
+result_t test_loop_objects() {
+  while (eer_loop_iteration(&core0) < 100 || eer_loop_iteration(&core1) < 200)
+    usleep(100);
+
+  eer_loop_stop(&core0);
+  while (!__atomic_load_n(&exits[0], __ATOMIC_ACQUIRE))
+    usleep(100);
+  test_assert(eer_loop_iteration(&core1) >= 200 && !exits[1],
+              "Stopping one loop should leave the other running");
+
+  eer_loop_stop(&core1);
+  while (!__atomic_load_n(&exits[1], __ATOMIC_ACQUIRE))
+    usleep(100);
+
+  test_assert(counter0.state.update_count == (int)core0.iteration,
+              "Registry should commit every apply of core 0, %d of %d",
+              counter0.state.update_count, (int)core0.iteration);
+  test_assert(counter1.state.update_count == (int)core1.iteration,
+              "Registry should commit every apply of core 1, %d of %d",
+              counter1.state.update_count, (int)core1.iteration);
+  test_assert(exits[0] == 1 && exits[1] == 1,
+              "Every loop should run its exit hook once");
+
+  usleep(10000);
+  test_assert(local_iterations == 3,
+              "Local loop should run until exit_when, ran %d",
+              local_iterations);
+
+  return OK;
+}
@@ -0,0 +1,101 @@
+/**
+ * Paced Loop Test
+ *
+ * This test runs a 1 kHz loop on absolute deadlines and checks that it does
+ * not drift, that wake-up jitter is recorded and that iterations running
+ * past their deadline count as overruns without shifting the phase of the
+ * following ones. It also paces a minute of virtual time in fast mode.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_sim.h>
+#include "test.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define HZ 1000
+#define PERIOD_US (1000000 / HZ)
+#define ITERATIONS 300
+#define SLOW_ITERATIONS 10
+#define MINUTE_US (60ull * 1000000)
+
+eer_loop_t paced_loop;
+eer_histogram_t jitter = {0};
+eer_histogram_t virtual_jitter = {0};
+
+uint64_t elapsed = 0;
+uint64_t overruns = 0;
+uint64_t phase = 1;
+uint64_t virtual_elapsed = 0;
+bool done = false;
+
+test(test_paced_loop) {
+  uint64_t start = eer_now_us();
+
+  eer_loop_init(&paced_loop, NULL);
+  eer_loop_spin(&paced_loop, 100);
+  eer_loop_jitter(&paced_loop, &jitter);
+  eer_loop_at(&paced_loop, HZ) {
+    exit_when(eer_loop_iteration(&paced_loop) == ITERATIONS);
+  }
+  elapsed = eer_now_us() - start;
+
+  // Every slow iteration sleeps through more than three periods
+  uint64_t first = 0;
+
+  eer_loop_init(&paced_loop, NULL);
+  eer_loop_at(&paced_loop, HZ) {
+    if (!first)
+      first = paced_loop.deadline;
+    usleep(3500);
+    exit_when(eer_loop_iteration(&paced_loop) == SLOW_ITERATIONS);
+  }
+  overruns = paced_loop.overruns;
+  phase = (paced_loop.deadline - first) % PERIOD_US;
+
+  eer_sim_clock(EER_SIM_FAST);
+  start = eer_now_us();
+  eer_loop_init(&paced_loop, NULL);
+  eer_loop_jitter(&paced_loop, &virtual_jitter);
+  eer_loop_at(&paced_loop, HZ) {
+    exit_when(eer_loop_iteration(&paced_loop) == MINUTE_US / PERIOD_US);
+  }
+  virtual_elapsed = eer_now_us() - start;
+  eer_sim_clock(EER_SIM_REALTIME);
+
+  done = true;
+}
+
+result_t test_paced_loop() {
+  while (!done)
+    usleep(1000);
+
+  eer_histogram_report(&jitter, "1 kHz wake-up jitter us", stdout);
+
+  test_assert(elapsed >= ITERATIONS * PERIOD_US &&
+                  elapsed < ITERATIONS * PERIOD_US * 11 / 10,
+              "%d iterations at %d Hz should take %d us, took %llu us",
+              ITERATIONS, HZ, ITERATIONS * PERIOD_US,
+              (unsigned long long)elapsed);
+  test_assert(jitter.count == ITERATIONS,
+              "Jitter should be recorded per iteration, got %llu",
+              (unsigned long long)jitter.count);
+  test_assert(eer_histogram_percentile(&jitter, 50) < PERIOD_US,
+              "Median jitter should stay below a period, got %llu us",
+              (unsigned long long)eer_histogram_percentile(&jitter, 50));
+  test_assert(overruns == SLOW_ITERATIONS,
+              "Every slow iteration should overrun, got %llu",
+              (unsigned long long)overruns);
+  test_assert(phase == 0, "Overruns should keep the deadline phase, off by %llu",
+              (unsigned long long)phase);
+  test_assert(virtual_elapsed == MINUTE_US,
+              "A paced virtual minute should take %llu us, took %llu us",
+              MINUTE_US, (unsigned long long)virtual_elapsed);
+  test_assert(virtual_jitter.max == 0,
+              "Virtual time should wake up exactly, max %llu us",
+              (unsigned long long)virtual_jitter.max);
+
+  return OK;
+}
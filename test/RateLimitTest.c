@@ -0,0 +1,113 @@
+/**
+ * Rate Limit Test
+ *
+ * This test replays a 10 kHz react stream against each rate policy with
+ * explicit timestamps, then drives a throttled component from a loop and
+ * checks that excess reacts collapse into deferred updates carrying the
+ * latest props.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_rate.h>
+#include "test.h"
+#include <stdio.h>
+#include <unistd.h>
+
+typedef struct {
+  int value;
+} Gauge_props_t;
+
+typedef struct {
+  int value;
+  int updates;
+} Gauge_state_t;
+
+eer_header(Gauge);
+
+WILL_MOUNT_SKIP(Gauge);
+SHOULD_UPDATE_SKIP(Gauge);
+WILL_UPDATE_SKIP(Gauge);
+
+RELEASE(Gauge) {
+  state->value = props->value;
+  state->updates++;
+}
+
+DID_MOUNT_SKIP(Gauge);
+DID_UPDATE_SKIP(Gauge);
+DID_UNMOUNT_SKIP(Gauge);
+
+eer_withprops(Gauge, gauge, _({.value = 0}));
+eer_limiter(Gauge, gauge, EER_RATE_THROTTLE, 5000);
+
+int updates[3];
+uint64_t debounce_at = 0;
+int reacts = 0;
+
+/* 100 ms of reacts every 100 us, then 100 ms of silence, flushing each 10 us */
+int replay(enum eer_rate_policy policy, uint64_t *last_update) {
+  eer_rate_t rate = {policy, 16667, 0, false, false};
+  int count = 0;
+
+  for (uint64_t now = 1000; now < 201000; now += 10) {
+    bool run = false;
+
+    if (now < 101000 && now % 100 == 0)
+      run = eer_rate_request(&rate, now);
+    run |= eer_rate_due(&rate, now);
+    if (run) {
+      count++;
+      *last_update = now;
+    }
+  }
+
+  return count;
+}
+
+test(test_rate_policies) {
+  uint64_t last_update;
+
+  updates[EER_RATE_THROTTLE] = replay(EER_RATE_THROTTLE, &last_update);
+  updates[EER_RATE_SAMPLE] = replay(EER_RATE_SAMPLE, &last_update);
+  updates[EER_RATE_DEBOUNCE] = replay(EER_RATE_DEBOUNCE, &debounce_at);
+
+  loop() {
+    if (eer_current_iteration < 2000) {
+      react_limited(Gauge, gauge, _({.value = (int)eer_current_iteration}));
+      reacts++;
+      usleep(10);
+    }
+    flush_limited(Gauge, gauge);
+
+    exit_when(eer_current_iteration >= 2000 && !gauge_rate.pending);
+  }
+}
+
+result_t test_rate_policies() {
+  test_wait_for_iteration(2001);
+  usleep(20000);
+
+  // 100 ms of input at 60 Hz
+  test_assert(updates[EER_RATE_THROTTLE] >= 6 &&
+                  updates[EER_RATE_THROTTLE] <= 8,
+              "Throttle should update about 6 times, got %d",
+              updates[EER_RATE_THROTTLE]);
+  test_assert(updates[EER_RATE_SAMPLE] >= 6 && updates[EER_RATE_SAMPLE] <= 7,
+              "Sampling should update about 6 times, got %d",
+              updates[EER_RATE_SAMPLE]);
+  test_assert(updates[EER_RATE_DEBOUNCE] == 1 && debounce_at == 100900 + 16670,
+              "Debounce should update once after the input settles, got %d "
+              "at %llu",
+              updates[EER_RATE_DEBOUNCE], (unsigned long long)debounce_at);
+  test_assert(gauge.state.updates < reacts / 2,
+              "Throttled component should collapse reacts, %d updates for %d "
+              "reacts",
+              gauge.state.updates, reacts);
+  test_assert(gauge.state.value == 1999,
+              "Trailing update should carry the latest props, got %d",
+              gauge.state.value);
+
+  return OK;
+}
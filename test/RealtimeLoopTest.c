@@ -0,0 +1,113 @@
+/**
+ * Realtime Loop Test
+ *
+ * This test configures a loop with CPU affinity and prefaulted stack and
+ * pool memory. It checks that the loop thread runs on the requested CPU and
+ * that writing the whole pool inside an iteration causes no page faults.
+ * SCHED_FIFO and mlockall depend on privileges, so the test only checks
+ * that a refusal is reported for those steps, on a thread of its own.
+ */
+
+#define _GNU_SOURCE
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include "test.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define POOL_SIZE (8 * 1024 * 1024)
+
+eer_loop_t realtime_loop;
+uint8_t *pool;
+int cpu = -1;
+int expected_cpu = -1;
+uint64_t pool_faults = ~0ull;
+uint8_t privileged_failed = 0xff;
+bool done = false;
+
+/* First CPU the process may run on */
+int allowed_cpu() {
+  cpu_set_t set;
+
+  if (sched_getaffinity(0, sizeof(set), &set))
+    return -1;
+  for (int index = 0; index < 64 && index < CPU_SETSIZE; index++)
+    if (CPU_ISSET(index, &set))
+      return index;
+
+  return -1;
+}
+
+/* SCHED_FIFO and mlockall stay on a thread that exits right away */
+void *privileged_thread(void *argument) {
+  eer_loop_attr_t privileged = {.priority = 10, .lock_memory = true};
+
+  privileged_failed = eer_realtime_apply(&privileged);
+  // Memory locks belong to the process, not to the thread
+  if (!(privileged_failed & EER_REALTIME_LOCK))
+    munlockall();
+
+  return NULL;
+}
+
+test(test_realtime_loop) {
+  pthread_t thread;
+  struct eer_region regions[] = {{0, POOL_SIZE}};
+
+  // CPU 0 may be outside the affinity of the process
+  expected_cpu = allowed_cpu();
+
+  eer_loop_attr_t attr = {.cpus = expected_cpu >= 0 ? 1ull << expected_cpu : 0,
+                          .prefault_stack = 128 * 1024,
+                          .regions = regions,
+                          .region_count = 1};
+
+  // Untouched pages of a large allocation fault on first write
+  pool = malloc(POOL_SIZE);
+  regions[0].address = pool;
+
+  eer_loop_init(&realtime_loop, NULL);
+  eer_loop_configure(&realtime_loop, &attr);
+  loop_on(&realtime_loop) {
+    uint64_t faults = eer_realtime_faults();
+
+    memset(pool, 1, POOL_SIZE);
+    pool_faults = eer_realtime_faults() - faults;
+    cpu = sched_getcpu();
+    exit_when(true);
+  }
+
+  pthread_create(&thread, NULL, privileged_thread, NULL);
+  pthread_join(thread, NULL);
+  free(pool);
+  done = true;
+}
+
+result_t test_realtime_loop() {
+  while (!done)
+    usleep(1000);
+
+  test_assert(realtime_loop.realtime_failed == 0,
+              "Affinity and prefaulting should succeed, failed mask %x",
+              realtime_loop.realtime_failed);
+  test_assert(expected_cpu >= 0 && cpu == expected_cpu,
+              "Loop should run on CPU %d, ran on %d", expected_cpu, cpu);
+  test_assert(pool_faults < 16,
+              "Prefaulted pool should not fault in the loop, %llu faults",
+              (unsigned long long)pool_faults);
+  test_assert(!(privileged_failed &
+                ~(EER_REALTIME_PRIORITY | EER_REALTIME_LOCK)),
+              "Only privileged steps may be refused, failed mask %x",
+              privileged_failed);
+  log_info("SCHED_FIFO %s, mlockall %s",
+           privileged_failed & EER_REALTIME_PRIORITY ? "refused" : "applied",
+           privileged_failed & EER_REALTIME_LOCK ? "refused" : "applied");
+
+  return OK;
+}
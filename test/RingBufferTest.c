@@ -0,0 +1,158 @@
+/**
+ * Ring Buffer Test
+ *
+ * This test checks the SPSC ring around its wrap point, including the
+ * zero-copy reserve/commit and peek/consume paths, and hammers the MPMC ring
+ * with several producer and consumer threads to verify that every item is
+ * delivered exactly once.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_ring.h>
+#include "test.h"
+#include <sched.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define PRODUCERS 4
+#define CONSUMERS 2
+#define ITEMS_PER_PRODUCER 20000
+
+eer_ring(int, spsc, 8);
+eer_mpmc(int, mpmc, 64);
+
+bool spsc_ordered = true;
+bool spsc_codes = false;
+bool spsc_zero_copy = false;
+bool init_checked = false;
+
+int consumed = 0;
+long consumed_sum = 0;
+int producers_done = 0;
+
+void check_spsc() {
+  int items[8], out[8], value = 0, expected = 0;
+
+  // Walk the indexes around the end of the buffer several times
+  for (int round = 0; round < 10; round++) {
+    for (int index = 0; index < 5; index++)
+      items[index] = value++;
+    if (eer_ring_push_batch(&spsc, items, 5) != 5)
+      spsc_ordered = false;
+
+    size_t count = eer_ring_pop_batch(&spsc, out, 8);
+
+    for (size_t index = 0; index < count; index++)
+      spsc_ordered &= out[index] == expected++;
+  }
+
+  // Reserved slots stop at the end of the buffer, peek sees them in place
+  size_t count = 8;
+  int *slots = eer_ring_reserve(&spsc, &count);
+  size_t wanted = count;
+
+  for (size_t index = 0; index < count; index++)
+    slots[index] = 100 + (int)index;
+  eer_ring_commit(&spsc, count);
+
+  count = 8;
+  int *first = eer_ring_peek(&spsc, &count);
+
+  spsc_zero_copy = first == slots && count == wanted && first[0] == 100;
+  eer_ring_consume(&spsc, count);
+
+  int item = 0;
+
+  spsc_codes = eer_ring_pop(&spsc, &item) == ERROR_BUFFER_EMPTY;
+  while (eer_ring_push(&spsc, &item) == OK)
+    ;
+  spsc_codes &= eer_ring_count(&spsc) == 8;
+  spsc_codes &= eer_ring_pop_batch(&spsc, out, 8) == 8;
+
+  eer_ring_t dynamic;
+  int storage[6];
+
+  init_checked =
+      eer_ring_init(&dynamic, storage, sizeof(int), 6) == ERROR_UNKNOWN &&
+      eer_ring_init(&dynamic, storage, sizeof(int), 4) == OK;
+}
+
+void *producer(void *argument) {
+  int base = *(int *)argument * ITEMS_PER_PRODUCER;
+
+  for (int index = 0; index < ITEMS_PER_PRODUCER; index++) {
+    int item = base + index;
+
+    // Give the consumers the core instead of spinning on a full ring
+    while (eer_mpmc_push(&mpmc, &item) == ERROR_BUFFER_FULL)
+      sched_yield();
+  }
+  __atomic_add_fetch(&producers_done, 1, __ATOMIC_RELEASE);
+
+  return NULL;
+}
+
+void *consumer(void *argument) {
+  int items[16];
+
+  for (;;) {
+    size_t count = eer_mpmc_pop_batch(&mpmc, items, 16);
+
+    for (size_t index = 0; index < count; index++)
+      __atomic_add_fetch(&consumed_sum, items[index], __ATOMIC_RELAXED);
+    __atomic_add_fetch(&consumed, (int)count, __ATOMIC_RELAXED);
+
+    if (count)
+      continue;
+    if (__atomic_load_n(&producers_done, __ATOMIC_ACQUIRE) == PRODUCERS &&
+        !eer_mpmc_count(&mpmc))
+      break;
+    sched_yield();
+  }
+
+  return NULL;
+}
+
+test(test_ring_buffers) {
+  pthread_t producers[PRODUCERS], consumers[CONSUMERS];
+  int ids[PRODUCERS];
+
+  check_spsc();
+
+  for (int index = 0; index < CONSUMERS; index++)
+    pthread_create(&consumers[index], NULL, consumer, NULL);
+  for (int index = 0; index < PRODUCERS; index++) {
+    ids[index] = index;
+    pthread_create(&producers[index], NULL, producer, &ids[index]);
+  }
+  for (int index = 0; index < PRODUCERS; index++)
+    pthread_join(producers[index], NULL);
+  for (int index = 0; index < CONSUMERS; index++)
+    pthread_join(consumers[index], NULL);
+
+  loop() { eer_land.state.unmounted = true; }
+}
+
+result_t test_ring_buffers() {
+  long total = (long)PRODUCERS * ITEMS_PER_PRODUCER;
+
+  test_wait_for_iteration(1);
+
+  test_assert(spsc_ordered, "SPSC ring should keep items in order");
+  test_assert(spsc_zero_copy,
+              "Peek should return the slots written after reserve");
+  test_assert(spsc_codes,
+              "SPSC ring should report ERROR_BUFFER_FULL and "
+              "ERROR_BUFFER_EMPTY");
+  test_assert(init_checked, "Init should reject capacities that are not a "
+                            "power of two");
+  test_assert(consumed == total, "MPMC ring should deliver %ld items, got %d",
+              total, consumed);
+  test_assert(consumed_sum == total * (total - 1) / 2,
+              "MPMC ring should deliver every item once, sum %ld",
+              consumed_sum);
+
+  return OK;
+}
@@ -0,0 +1,110 @@
+/**
+ * Screen Test
+ *
+ * This test draws a counter component into a screen written to a pipe. It
+ * checks that the first render clears the terminal and draws the text, that
+ * a frame without changes writes nothing, that changing one digit emits
+ * only a cursor move, a color and the glyph, and that a screen that is not
+ * a terminal falls back to 24x80.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_screen.h>
+#include "test.h"
+#include <string.h>
+#include <unistd.h>
+
+#define FRAMES 12
+
+eer_screen_t screen;
+eer_loop_t screen_loop;
+int pipe_fds[2];
+size_t written[FRAMES];
+uint16_t rows, cols;
+char first[256];
+
+typedef struct {
+  int value;
+} Counter_props_t;
+
+typedef struct {
+  int value;
+} Counter_state_t;
+
+eer_header(Counter);
+
+WILL_MOUNT(Counter) { state->value = props->value; }
+SHOULD_UPDATE(Counter) { return props->value != next_props->value; }
+WILL_UPDATE_SKIP(Counter);
+RELEASE(Counter) { state->value = props->value; }
+
+DID_MOUNT(Counter) {
+  eer_screen_color(&screen, EER_SCREEN_CYAN, EER_SCREEN_BLACK);
+  eer_screen_print(&screen, 2, 10, "Counter: %d", state->value);
+}
+
+DID_UPDATE(Counter) {
+  eer_screen_color(&screen, EER_SCREEN_CYAN, EER_SCREEN_BLACK);
+  eer_screen_print(&screen, 2, 10, "Counter: %d", state->value);
+}
+
+DID_UNMOUNT_SKIP(Counter);
+
+eer_withprops(Counter, counter, _({.value = 0}));
+
+bool done = false;
+
+test(test_screen) {
+  pipe(pipe_fds);
+  eer_screen_init(&screen, pipe_fds[1]);
+
+  eer_loop_init(&screen_loop, NULL);
+  loop_on(&screen_loop) {
+    uint64_t iteration = eer_loop_iteration(&screen_loop);
+
+    // The value changes every fourth frame, from 0 to 1, 2
+    react(Counter, counter, _({.value = (int)(iteration / 4)}));
+    written[iteration] = eer_screen_render(&screen);
+    if (iteration == 0)
+      read(pipe_fds[0], first, sizeof(first));
+    else if (written[iteration])
+      read(pipe_fds[0], first + 128, sizeof(first) - 128);
+    exit_when(iteration == FRAMES - 1);
+  }
+
+  rows = screen.rows;
+  cols = screen.cols;
+  eer_screen_release(&screen);
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+  done = true;
+}
+
+result_t test_screen() {
+  while (!done)
+    usleep(1000);
+
+  log_info("First frame %zu bytes, update %zu bytes", written[0], written[4]);
+
+  test_assert(screen.frames == 3 && screen.bytes == written[0] + written[4]
+                                                      + written[8],
+              "Only frames with changes should be written, %llu frames",
+              (unsigned long long)screen.frames);
+  test_assert(!memcmp(first, "\033[0m\033[2J", 8)
+                  && strstr(first + 8, "Counter: 0"),
+              "The first frame should clear and draw the text");
+  test_assert(written[1] == 0 && written[2] == 0 && written[3] == 0,
+              "A frame without changes should write nothing");
+  test_assert(written[4] > 0 && written[4] <= 24,
+              "One changed digit should cost a move, a color and a glyph, "
+              "%zu bytes",
+              written[4]);
+  test_assert(!memcmp(first + 128, "\033[3;20H\033[36;40m2\033[0m", 20),
+              "The update should draw the digit in place");
+  test_assert(rows == 24 && cols == 80,
+              "A pipe should get the default size, %ux%u", rows, cols);
+
+  return OK;
+}
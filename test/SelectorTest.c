@@ -0,0 +1,142 @@
+/**
+ * Selector Test
+ *
+ * This test shares a selector over the state of two sensor components
+ * between three gauge components. It checks that the value is computed once
+ * per change of an input field however many gauges read it, also when a
+ * sensor releases without changing the field, that every gauge sees the
+ * current value, and that eer_changed() reports each release of a sensor
+ * once.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_select.h>
+#include "test.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define GAUGES 3
+#define ITERATIONS 100
+
+typedef struct {
+  int watts;
+} Sensor_props_t;
+
+typedef struct {
+  int watts;
+  int samples;
+} Sensor_state_t;
+
+eer_header(Sensor);
+
+WILL_MOUNT_SKIP(Sensor);
+SHOULD_UPDATE_SKIP(Sensor);
+WILL_UPDATE_SKIP(Sensor);
+RELEASE(Sensor) {
+  state->watts = props->watts;
+  state->samples++;
+}
+DID_MOUNT_SKIP(Sensor);
+DID_UPDATE_SKIP(Sensor);
+DID_UNMOUNT_SKIP(Sensor);
+
+eer_withprops(Sensor, left, _({0}));
+eer_withprops(Sensor, right, _({0}));
+
+void total_power(void *context, void *value) {
+  (void)context;
+  *(int *)value = left.state.watts + right.state.watts;
+}
+
+eer_selector(int, power, total_power, NULL,
+             eer_select_input(left, state.watts),
+             eer_select_input(right, state.watts));
+
+typedef struct {
+  int sample;
+} Gauge_props_t;
+
+typedef struct {
+  int power;
+} Gauge_state_t;
+
+eer_header(Gauge);
+
+WILL_MOUNT_SKIP(Gauge);
+SHOULD_UPDATE_SKIP(Gauge);
+WILL_UPDATE_SKIP(Gauge);
+int reads = 0;
+
+RELEASE(Gauge) {
+  state->power = eer_select(int, power);
+  reads++;
+}
+DID_MOUNT_SKIP(Gauge);
+DID_UPDATE_SKIP(Gauge);
+DID_UNMOUNT_SKIP(Gauge);
+
+eer_withprops(Gauge, gauge0, _({0}));
+eer_withprops(Gauge, gauge1, _({0}));
+eer_withprops(Gauge, gauge2, _({0}));
+
+bool current = true;
+int changes = 0;
+int seen_changes = 0;
+uint32_t seen = 0;
+
+test(test_selector) {
+  for (int iteration = 0; iteration < ITERATIONS; iteration++) {
+    // Left changes every 10th iteration, right every 25th
+    int left_watts = iteration / 10;
+    int right_watts = iteration / 25 * 100;
+
+    changes += iteration && (left_watts != left.state.watts ||
+                             right_watts != right.state.watts);
+    if (!iteration || left_watts != left.state.watts)
+      react(Sensor, left, _({.watts = left_watts}));
+    // Right releases every iteration, its samples count up
+    react(Sensor, right, _({.watts = right_watts}));
+    seen_changes += eer_changed(left, seen);
+
+    react(Gauge, gauge0, _({.sample = iteration}));
+    react(Gauge, gauge1, _({.sample = iteration}));
+    react(Gauge, gauge2, _({.sample = iteration}));
+
+    current &= gauge0.state.power == left_watts + right_watts &&
+               gauge1.state.power == gauge0.state.power &&
+               gauge2.state.power == gauge0.state.power;
+  }
+
+  loop() { eer_land.state.unmounted = true; }
+}
+
+result_t test_selector() {
+  test_wait_for_iteration(1);
+
+  log_info("%llu computations, %llu cached reads",
+           (unsigned long long)power.computes,
+           (unsigned long long)power.hits);
+
+  test_assert(current, "Every gauge should read the current total");
+  test_assert(power.computes == (uint64_t)changes + 1,
+              "The total should be computed once per change, %llu for %d "
+              "changes",
+              (unsigned long long)power.computes, changes);
+  test_assert(power.computes + power.hits == (uint64_t)reads &&
+                  reads >= GAUGES * ITERATIONS,
+              "Every other read should hit the cache, %llu hits",
+              (unsigned long long)power.hits);
+  test_assert(right.state.samples >= ITERATIONS,
+              "Right should release every iteration, %d releases",
+              right.state.samples);
+  test_assert(seen_changes == ITERATIONS / 10 &&
+                  seen == eer_version(left) &&
+                  eer_version(left) == (uint32_t)left.state.samples,
+              "Each change of a sensor should be seen once, %d times at "
+              "version %u",
+              seen_changes, eer_version(left));
+
+  return OK;
+}
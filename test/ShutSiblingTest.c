@@ -0,0 +1,71 @@
+/**
+ * Shut Sibling Test
+ *
+ * This test verifies that a component shut inside a loop does not block
+ * the updates of the other components of the same loop.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include "test.h"
+#include <stdio.h>
+
+typedef struct {
+  int value;
+} SiblingComponent_props_t;
+
+typedef struct {
+  int value;
+  int unmounts;
+} SiblingComponent_state_t;
+
+eer_header(SiblingComponent);
+
+WILL_MOUNT(SiblingComponent) { state->value = props->value; }
+RELEASE(SiblingComponent) { state->value = props->value; }
+DID_UNMOUNT(SiblingComponent) { state->unmounts++; }
+
+// Loops restage their components every iteration, update on new props only
+SHOULD_UPDATE(SiblingComponent) {
+  return next_props && props->value != next_props->value;
+}
+
+WILL_UPDATE_SKIP(SiblingComponent);
+DID_MOUNT_SKIP(SiblingComponent);
+DID_UPDATE_SKIP(SiblingComponent);
+
+eer_withprops(SiblingComponent, first, _({.value = 1}));
+eer_withprops(SiblingComponent, second, _({.value = 2}));
+
+test(test_shut_sibling) {
+  loop(first, second) {
+    if (eer_current_iteration == 0) {
+      eer_shut(second);
+    }
+
+    if (eer_current_iteration >= 1) {
+      apply(SiblingComponent, first, _({.value = 7}));
+    }
+
+    if (eer_current_iteration >= 3) {
+      eer_land.state.unmounted = true;
+    }
+  }
+}
+
+result_t test_shut_sibling() {
+  test_wait_for_iteration(4);
+
+  test_assert(first.state.value == 7,
+              "The remaining component should be applied, got %d",
+              first.state.value);
+  test_assert(second.state.unmounts == 1,
+              "The shut component should unmount once, got %d",
+              second.state.unmounts);
+  test_assert(second.instance.stage.state.step == EER_STAGE_BLOCKED,
+              "The shut component should stay blocked, got %d",
+              second.instance.stage.state.step);
+
+  return OK;
+}
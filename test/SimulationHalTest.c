@@ -0,0 +1,139 @@
+/**
+ * Simulation HAL Test
+ *
+ * This test runs an hour of a blinking, logging component against the
+ * virtual clock in fast mode and checks that it finishes in well under a
+ * second with exact timestamps. It also exercises the GPIO and UART stubs
+ * and a throttled component on virtual time.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_sim.h>
+#include "test.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define HOUR_US (3600ull * 1000000)
+
+typedef struct {
+  eer_pin_t *pin;
+  uint64_t time;
+} Blinker_props_t;
+
+typedef struct {
+  int blinks;
+  uint64_t last_time;
+} Blinker_state_t;
+
+eer_header(Blinker);
+
+WILL_MOUNT(Blinker) { hw(gpio).mode(props->pin, EER_PIN_OUTPUT); }
+SHOULD_UPDATE(Blinker) { return props->time != next_props->time; }
+WILL_UPDATE_SKIP(Blinker);
+
+RELEASE(Blinker) {
+  hw(gpio).toggle(props->pin);
+  state->blinks++;
+  state->last_time = props->time;
+}
+
+DID_MOUNT_SKIP(Blinker);
+DID_UPDATE_SKIP(Blinker);
+DID_UNMOUNT_SKIP(Blinker);
+
+pin_t led = hw_pin(1, 5);
+pin_t button = hw_pin(2, 3);
+
+eer_withprops(Blinker, blinker, _({.pin = &led, .time = 0}));
+eer_limiter(Blinker, blinker, EER_RATE_THROTTLE, 10000000);
+
+eer_timer_t tick;
+int ticks = 0;
+double wall_seconds = 0;
+bool gpio_checked = false;
+bool uart_checked = false;
+bool led_matches = false;
+bool forever_returned = false;
+
+eer_result_t on_tick(void *argument, void *trigger) {
+  (*(int *)argument)++;
+
+  return OK;
+}
+
+void check_peripherals() {
+  uint8_t buffer[16];
+
+  hw(gpio).mode(&button, EER_PIN_INPUT_PULLUP);
+  gpio_checked = hw(gpio).get(&button);
+  eer_sim_gpio_drive(&button, false);
+  gpio_checked &= !hw(gpio).get(&button);
+
+  uart_checked = eer_sim_uart_receive((const uint8_t *)"ping", 4) == 4 &&
+                 hw(uart).read(buffer, sizeof(buffer)) == 4 &&
+                 !memcmp(buffer, "ping", 4);
+  uart_checked &= hw(uart).write((const uint8_t *)"pong", 4) == OK &&
+                  eer_sim_uart_transmitted(buffer, sizeof(buffer)) == 4 &&
+                  !memcmp(buffer, "pong", 4);
+}
+
+test(test_simulation_hal) {
+  struct timespec start, end;
+
+  check_peripherals();
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  eer_sim_clock(EER_SIM_FAST);
+  uint64_t begin = eer_now_us();
+
+  // One tick per second for an hour, the blinker is throttled to 10 s
+  hw(timer).start(&tick, 1000000, 1000000, (eer_callback_t){on_tick, &ticks});
+
+  loop() {
+    react_limited(Blinker, blinker,
+                  _({.pin = &led, .time = eer_now_us() - begin}));
+    flush_limited(Blinker, blinker);
+
+    if (eer_now_us() - begin < HOUR_US)
+      hw(timer).sleep_until(hw(timer).next_deadline());
+    else
+      eer_land.state.unmounted = true;
+  }
+
+  // Only the periodic tick is armed, waiting forever returns at once
+  uint64_t parked = eer_now_us();
+
+  hw(timer).sleep_until(UINT64_MAX);
+  forever_returned = eer_now_us() == parked;
+
+  hw(timer).stop(&tick);
+  led_matches = hw(gpio).get(&led) == (blinker.state.blinks % 2);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  wall_seconds =
+      (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+result_t test_simulation_hal() {
+  while (!wall_seconds)
+    usleep(1000);
+
+  test_assert(gpio_checked, "GPIO stub should follow pull-ups and drives");
+  test_assert(uart_checked, "UART stub should loop bytes through its rings");
+  test_assert(ticks == 3600, "Timer should fire every second, got %d", ticks);
+  test_assert(blinker.state.blinks >= 360 && blinker.state.blinks <= 362,
+              "Throttled blinker should update every 10 s, got %d",
+              blinker.state.blinks);
+  test_assert(blinker.state.last_time == HOUR_US,
+              "Last update should carry the virtual time, got %llu",
+              (unsigned long long)blinker.state.last_time);
+  test_assert(forever_returned,
+              "Waiting forever on periodic timers should return in fast mode");
+  test_assert(led_matches, "LED should toggle on every blink");
+  test_assert(wall_seconds < 1.0, "Simulated hour should take %.3f s",
+              wall_seconds);
+
+  return OK;
+}
@@ -0,0 +1,132 @@
+/**
+ * Snapshot Test
+ *
+ * This test mounts a component that builds a lookup table in will_mount,
+ * saves it to a snapshot file and restores it into a zeroed component, as a
+ * new process would on start. It checks that the restored component is
+ * RELEASED with the saved state and version without mounting again, that its
+ * registry sees nothing pending, that it keeps updating, and that a snapshot of another schema is rejected without
+ * touching the component.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_registry.h>
+#include <eer_snapshot.h>
+#include "test.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define ENTRIES 1024
+
+typedef struct {
+  int scale;
+  int lookup;
+} Table_props_t;
+
+typedef struct {
+  int table[ENTRIES];
+  int value;
+} Table_state_t;
+
+eer_header(Table);
+
+int mounts = 0;
+int releases = 0;
+
+WILL_MOUNT(Table) {
+  for (int index = 0; index < ENTRIES; index++)
+    state->table[index] = index * index * props->scale;
+  mounts++;
+}
+SHOULD_UPDATE_SKIP(Table);
+WILL_UPDATE_SKIP(Table);
+RELEASE(Table) {
+  state->value = state->table[props->lookup % ENTRIES];
+  releases++;
+}
+DID_MOUNT_SKIP(Table);
+DID_UPDATE_SKIP(Table);
+DID_UNMOUNT_SKIP(Table);
+
+eer_withprops(Table, table, _({.scale = 3}));
+
+eer_snapshot(warm, 4, 1);
+eer_snapshot(other, 4, 2);
+eer_registry(tables, 4);
+
+Table_t saved;
+eer_result_t saving = ERROR_UNKNOWN;
+eer_result_t restoring = ERROR_UNKNOWN;
+eer_result_t rejecting = OK;
+eer_result_t missing = OK;
+bool restored = false;
+bool settled = false;
+bool untouched = false;
+int value = 0;
+
+test(test_snapshot) {
+  char path[] = "/tmp/eer-snapshot-XXXXXX";
+  int fd = mkstemp(path);
+
+  close(fd);
+  react(Table, table, _({.scale = 3, .lookup = 7}));
+
+  eer_snapshot_add(&warm, Table, table);
+  eer_snapshot_add(&other, Table, table);
+  saving = eer_snapshot_save(&warm, path);
+  saved = table;
+
+  // Start again: the component is defined and empty
+  memset(&table.props, 0, sizeof(table.props) + sizeof(table.state));
+  table.instance.stage.state.step = EER_STAGE_DEFINED;
+  table.instance.version = 0;
+  eer_registry_add(&tables, &table.instance, NULL);
+
+  restoring = eer_snapshot_restore(&warm, path);
+  settled = eer_registry_next(&tables, 0) == tables.used;
+  restored = !memcmp(&table.props, &saved.props,
+                     sizeof(table.props) + sizeof(table.state)) &&
+             EER_STAGE_RELEASED == table.instance.stage.state.step &&
+             eer_version(table) == eer_version(saved);
+
+  react(Table, table, _({.scale = 3, .lookup = 9}));
+  value = table.state.value;
+
+  // A snapshot of another schema leaves the component as it is
+  saved = table;
+  rejecting = eer_snapshot_restore(&other, path);
+  missing = eer_snapshot_restore(&warm, "/tmp/eer-snapshot-missing");
+  untouched = !memcmp(&table, &saved, sizeof(table));
+
+  unlink(path);
+
+  loop() { eer_land.state.unmounted = true; }
+}
+
+result_t test_snapshot() {
+  test_wait_for_iteration(1);
+
+  log_info("%d mounts, %d releases", mounts, releases);
+
+  test_assert(OK == saving && OK == restoring,
+              "The snapshot should be saved and restored, %d and %d", saving,
+              restoring);
+  test_assert(restored,
+              "The restored component should be released with the saved "
+              "state and version");
+  test_assert(settled, "The registry should see the restored component as "
+                       "released");
+  test_assert(mounts == 1, "The restored component should not mount again, "
+                           "%d mounts", mounts);
+  test_assert(value == 9 * 9 * 3,
+              "The restored table should serve updates, got %d", value);
+  test_assert(OK != rejecting && OK != missing && untouched,
+              "Another schema or a missing file should leave the component "
+              "untouched");
+
+  return OK;
+}
@@ -0,0 +1,124 @@
+/**
+ * Stage Scan Test
+ *
+ * This test verifies that the registry scan finds exactly the pending
+ * components, with every scan implementation the CPU supports.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_registry.h>
+#include "test.h"
+#include <stdio.h>
+
+#define SCAN_COMPONENTS 100
+
+typedef struct {
+  int value;
+} ScanComponent_props_t;
+
+typedef struct {
+  int value;
+  int update_count;
+} ScanComponent_state_t;
+
+eer_header(ScanComponent);
+
+WILL_MOUNT_SKIP(ScanComponent);
+SHOULD_UPDATE_SKIP(ScanComponent);
+WILL_UPDATE_SKIP(ScanComponent);
+
+RELEASE(ScanComponent) {
+  state->value = props->value;
+  state->update_count++;
+}
+
+DID_MOUNT_SKIP(ScanComponent);
+DID_UPDATE_SKIP(ScanComponent);
+DID_UNMOUNT_SKIP(ScanComponent);
+
+ScanComponent_t scanComponents[SCAN_COMPONENTS];
+eer_registry(scanRegistry, SCAN_COMPONENTS);
+
+/* Components touched after mounting, including both ends of the array */
+const size_t touched[] = {0, 17, 31, 32, 63, 64, 98, 99};
+#define TOUCHED (sizeof(touched) / sizeof(*touched))
+
+int mounted_updates = 0;
+bool scans_agree = true;
+size_t pending_found = 0;
+
+void after_mount(void *data) {
+  int *updates = (int *)data;
+  for (size_t index = 0; index < SCAN_COMPONENTS; index++)
+    *updates += scanComponents[index].state.update_count;
+}
+
+void check_scans(enum eer_registry_scan scan) {
+  size_t found = 0;
+
+  if (OK != eer_registry_select(scan))
+    return;
+
+  for (size_t index = eer_registry_next(&scanRegistry, 0);
+       index < scanRegistry.used;
+       index = eer_registry_next(&scanRegistry, index + 1)) {
+    if (found >= TOUCHED || touched[found] != index)
+      scans_agree = false;
+    found++;
+  }
+  if (found != TOUCHED)
+    scans_agree = false;
+  pending_found = found;
+}
+
+test(test_stage_scan) {
+  for (size_t index = 0; index < SCAN_COMPONENTS; index++) {
+    scanComponents[index] = (ScanComponent_t){
+        .instance = eer_define_component(ScanComponent, scan)};
+    eer_registry_add(&scanRegistry, &scanComponents[index].instance, NULL);
+  }
+
+  test_hook_after_iteration(1, after_mount, &mounted_updates);
+
+  loop() {
+    eer_registry_staging(&scanRegistry);
+
+    if (eer_current_iteration == 1) {
+      for (size_t index = 0; index < TOUCHED; index++) {
+        scanComponents[touched[index]].instance.stage.state.step =
+            EER_STAGE_REACTING;
+        eer_registry_sync(&scanRegistry, touched[index]);
+      }
+      check_scans(EER_REGISTRY_SCAN_SCALAR);
+      check_scans(EER_REGISTRY_SCAN_SSE2);
+      check_scans(EER_REGISTRY_SCAN_AVX2);
+      eer_registry_select(EER_REGISTRY_SCAN_AUTO);
+    }
+
+    if (eer_current_iteration >= 2) {
+      eer_land.state.unmounted = true;
+    }
+  }
+}
+
+result_t test_stage_scan() {
+  test_wait_for_iteration(3);
+
+  test_assert(mounted_updates == SCAN_COMPONENTS,
+              "All %d components should mount through the registry, got %d",
+              SCAN_COMPONENTS, mounted_updates);
+  test_assert(scans_agree, "Every scan should find exactly the touched "
+                           "components, last scan found %zu",
+              pending_found);
+
+  int touched_updates = 0;
+  for (size_t index = 0; index < TOUCHED; index++)
+    touched_updates += scanComponents[touched[index]].state.update_count;
+  test_assert(touched_updates == 2 * TOUCHED,
+              "Touched components should update once more, got %d",
+              touched_updates);
+
+  return OK;
+}
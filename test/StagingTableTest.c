@@ -0,0 +1,183 @@
+/**
+ * Staging Table Test
+ *
+ * This test drives eer_staging through every (stage, context) pair and
+ * verifies the hooks that ran, the resulting stage and the returned context
+ * against the behaviour eer_staging had before the transition table. It
+ * also checks that a stage set by a hook survives the transition.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include "test.h"
+#include <stdio.h>
+
+typedef struct {
+  int value;
+} TableComponent_props_t;
+
+typedef struct {
+  uint8_t actions;
+  bool accept;
+} TableComponent_state_t;
+
+eer_header(TableComponent);
+
+WILL_MOUNT(TableComponent) { state->actions |= EER_ACTION_WILL_MOUNT; }
+
+SHOULD_UPDATE(TableComponent) {
+  state->actions |= EER_ACTION_SHOULD_UPDATE;
+  return state->accept;
+}
+
+WILL_UPDATE(TableComponent) { state->actions |= EER_ACTION_WILL_UPDATE; }
+RELEASE(TableComponent) { state->actions |= EER_ACTION_RELEASE; }
+DID_MOUNT(TableComponent) { state->actions |= EER_ACTION_DID_MOUNT; }
+DID_UPDATE(TableComponent) { state->actions |= EER_ACTION_DID_UPDATE; }
+DID_UNMOUNT(TableComponent) { state->actions |= EER_ACTION_DID_UNMOUNT; }
+
+eer_withprops(TableComponent, tableComponent, _({.value = 0}));
+
+/* Behaviour of eer_staging before the transition table, per context */
+#define MOUNT                                                                  \
+  {EER_ACTION_WILL_MOUNT | EER_ACTION_RELEASE | EER_ACTION_DID_MOUNT,          \
+   EER_STAGE_RELEASED, EER_CONTEXT_UPDATED}
+#define PREPARE                                                                \
+  {EER_ACTION_SHOULD_UPDATE | EER_ACTION_WILL_UPDATE, EER_STAGE_PREPARED,      \
+   EER_CONTEXT_UPDATED}
+#define REACT                                                                  \
+  {EER_ACTION_WILL_UPDATE | EER_ACTION_RELEASE | EER_ACTION_DID_UPDATE,        \
+   EER_STAGE_RELEASED, EER_CONTEXT_UPDATED}
+#define COMMIT                                                                 \
+  {EER_ACTION_RELEASE | EER_ACTION_DID_UPDATE, EER_STAGE_RELEASED,             \
+   EER_CONTEXT_UPDATED}
+#define UNMOUNT {EER_ACTION_DID_UNMOUNT, EER_STAGE_BLOCKED, EER_CONTEXT_UPDATED}
+#define IDLE(stage, context) {0, stage, context}
+
+#define STAGES (EER_STAGE_UNMOUNTED + 1)
+
+const struct eer_transition expected_transitions[STAGES][4] = {
+    [EER_STAGE_BLOCKED] = {IDLE(EER_STAGE_BLOCKED, EER_CONTEXT_SAME),
+                           IDLE(EER_STAGE_BLOCKED, EER_CONTEXT_UPDATED),
+                           IDLE(EER_STAGE_BLOCKED, EER_CONTEXT_UPDATED),
+                           IDLE(EER_STAGE_BLOCKED, EER_CONTEXT_UPDATED)},
+    [EER_STAGE_RELEASED] = {IDLE(EER_STAGE_RELEASED, EER_CONTEXT_SAME),
+                            PREPARE, UNMOUNT, PREPARE},
+    [EER_STAGE_DEFINED] = {MOUNT, MOUNT, UNMOUNT, MOUNT},
+    [EER_STAGE_REACTING] = {REACT, REACT, UNMOUNT, REACT},
+    [EER_STAGE_PREPARED] = {COMMIT, COMMIT, UNMOUNT, COMMIT},
+    [EER_STAGE_UNMOUNTED] = {UNMOUNT, UNMOUNT, UNMOUNT, UNMOUNT},
+};
+
+int transitions_checked = 0;
+int transitions_failed = 0;
+
+void check_transition(uint8_t stage, uint8_t column, bool accept) {
+  const struct eer_transition *expected = &expected_transitions[stage][column];
+  TableComponent_props_t next_props = {.value = 1};
+  void *argument = EER_TRANSITION_PROPS == column ? (void *)&next_props
+                                                  : (void *)(uintptr_t)column;
+  uint8_t actions = expected->actions;
+  uint8_t next = expected->next;
+  enum eer_context context = (enum eer_context)expected->context;
+
+  // A rejecting should_update stops the transition right after the gate
+  if ((actions & EER_ACTION_SHOULD_UPDATE) && !accept) {
+    actions = EER_ACTION_SHOULD_UPDATE;
+    next = stage;
+    context = EER_CONTEXT_SAME;
+  }
+
+  tableComponent.state.actions = 0;
+  tableComponent.state.accept = accept;
+  tableComponent.instance.stage.state.step = stage;
+
+  enum eer_context result = eer_staging(&tableComponent.instance, argument);
+
+  transitions_checked++;
+  if (result != context || tableComponent.state.actions != actions ||
+      tableComponent.instance.stage.state.step != next) {
+    transitions_failed++;
+    log_info("Transition [%d][%d] accept=%d: context %d/%d, actions %x/%x, "
+             "stage %d/%d",
+             stage, column, accept, result, context,
+             tableComponent.state.actions, actions,
+             tableComponent.instance.stage.state.step, next);
+  }
+}
+
+/* Unmounts itself from did_update */
+typedef struct {
+  int value;
+} Quitter_props_t;
+
+typedef struct {
+  int unmounts;
+} Quitter_state_t;
+
+eer_header(Quitter);
+
+WILL_MOUNT_SKIP(Quitter);
+SHOULD_UPDATE_SKIP(Quitter);
+WILL_UPDATE_SKIP(Quitter);
+RELEASE_SKIP(Quitter);
+DID_MOUNT_SKIP(Quitter);
+DID_UPDATE(Quitter) {
+  if (props->value)
+    self->stage.state.step = EER_STAGE_UNMOUNTED;
+}
+DID_UNMOUNT(Quitter) { state->unmounts++; }
+
+eer_withprops(Quitter, quitter, _({0}));
+
+int quitter_unmounts = 0;
+uint8_t quitter_step = EER_STAGE_RELEASED;
+
+test(test_staging_table) {
+  loop() {
+    if (eer_current_iteration == 0) {
+      for (uint8_t stage = 0; stage < STAGES; stage++)
+        for (uint8_t column = 0; column < EER_TRANSITION_CONTEXTS; column++) {
+          check_transition(stage, column, true);
+          check_transition(stage, column, false);
+        }
+
+      // A hook changing its own stage keeps that stage
+      react(Quitter, quitter, _({.value = 1}));
+      eer_staging(&quitter.instance, (void *)EER_CONTEXT_SAME);
+      quitter_unmounts = quitter.state.unmounts;
+      quitter_step = quitter.instance.stage.state.step;
+    }
+
+    if (eer_current_iteration >= 1) {
+      eer_land.state.unmounted = true;
+    }
+  }
+}
+
+result_t test_staging_table() {
+  test_wait_for_iteration(2);
+
+  test_assert(transitions_checked == 2 * STAGES * EER_TRANSITION_CONTEXTS,
+              "Every transition should be checked, got %d",
+              transitions_checked);
+  test_assert(transitions_failed == 0,
+              "Every transition should behave as before the table, %d "
+              "failed",
+              transitions_failed);
+  test_assert(eer_transitions[EER_STAGE_RELEASED][EER_CONTEXT_SAME].actions ==
+                  0,
+              "Released components should stay idle without a new context");
+  test_assert(eer_transitions[EER_STAGE_REACTING][EER_TRANSITION_PROPS]
+                      .actions ==
+                  (EER_ACTION_WILL_UPDATE | EER_ACTION_RELEASE |
+                   EER_ACTION_DID_UPDATE),
+              "Reacting components should run the whole update at once");
+  test_assert(quitter_unmounts == 1 && quitter_step == EER_STAGE_BLOCKED,
+              "A did_update setting UNMOUNTED should unmount, %d unmounts at "
+              "stage %d",
+              quitter_unmounts, quitter_step);
+
+  return OK;
+}
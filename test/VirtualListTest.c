@@ -0,0 +1,154 @@
+/**
+ * Virtual List Test
+ *
+ * This test shows a list of 100000 items through a window of 10 rows. It
+ * checks that only the window is mounted, that an idle iteration touches no
+ * child, that scrolling recycles the slots of the items that left instead of
+ * remounting, that shrinking the list unmounts the empty rows and that each
+ * child shows the item of its row. A list without rows stages nothing.
+ */
+
+#include <eer.h>
+#include <eer_app.h>
+#include <eer_comp.h>
+#include <eer_list.h>
+#include "test.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define ITEMS 100000
+#define ROWS 10
+
+// Compared byte by byte, no padding
+typedef struct {
+  size_t index;
+  size_t row;
+} Row_props_t;
+
+typedef struct {
+  size_t index;
+} Row_state_t;
+
+eer_header(Row);
+
+int mounted = 0;
+int unmounted = 0;
+int updated = 0;
+int item_calls = 0;
+
+WILL_MOUNT(Row) { mounted++; }
+SHOULD_UPDATE_SKIP(Row);
+WILL_UPDATE_SKIP(Row);
+RELEASE(Row) { state->index = props->index; }
+DID_MOUNT_SKIP(Row);
+DID_UPDATE(Row) { updated++; }
+DID_UNMOUNT(Row) { unmounted++; }
+
+void row_props(void *context, size_t index, uint16_t row, void *props) {
+  (void)context;
+  item_calls++;
+  *(Row_props_t *)props = (Row_props_t){.index = index, .row = row};
+}
+
+eer_list(Row, rows, ROWS, row_props, NULL);
+eer_list(Row, empty, 0, row_props, NULL);
+
+struct step {
+  int mounted, unmounted, updated;
+  uint64_t recycles;
+  size_t offset;
+  bool shown;
+} steps[6];
+
+/* Every slot shows the item of its row */
+bool rows_shown() {
+  for (uint16_t slot = 0; slot < ROWS; slot++) {
+    Row_t *row = (Row_t *)eer_list_child(&rows, slot);
+
+    if (rows.bound[slot] == EER_LIST_NONE)
+      continue;
+    if (row->state.index != rows.bound[slot] ||
+        row->props.row != rows.bound[slot] - rows.offset)
+      return false;
+  }
+
+  return true;
+}
+
+enum eer_context empty_context = EER_CONTEXT_UPDATED;
+int recorded = 0;
+
+void record(void *data) {
+  steps[recorded++] = (struct step){mounted, unmounted, updated, rows.recycles,
+                                    rows.offset, rows_shown()};
+}
+
+test(test_virtual_list) {
+  eer_list_resize(&rows, ITEMS);
+  eer_list_resize(&empty, ITEMS);
+  for (int step = 1; step <= 6; step++)
+    test_hook_after_iteration(step, record, NULL);
+
+  loop() {
+    switch (eer_current_iteration) {
+    case 2:
+      // One row enters, the slot of item 0 is reused for item 10
+      eer_list_scroll(&rows, 1);
+      break;
+    case 3:
+      // A long jump rebinds every slot, still without remounting
+      eer_list_scroll(&rows, ITEMS);
+      break;
+    case 4:
+      // Five items are left, the other rows unmount
+      eer_list_resize(&rows, 5);
+      break;
+    }
+
+    // Iteration 1 changes nothing, no child is touched
+    if (eer_current_iteration < 5) {
+      eer_list_staging(&rows);
+      empty_context = eer_list_staging(&empty);
+    } else {
+      eer_list_shut(&rows);
+      eer_land.state.unmounted = true;
+    }
+  }
+}
+
+result_t test_virtual_list() {
+  test_wait_for_iteration(6);
+
+  test_assert(steps[0].mounted == ROWS && steps[0].shown,
+              "Only the window should mount, %d children", steps[0].mounted);
+  test_assert(steps[1].updated == 0 && steps[1].mounted == ROWS,
+              "An idle iteration should update no child, %d updates",
+              steps[1].updated);
+  test_assert(steps[2].recycles == 1 && steps[2].mounted == ROWS &&
+                  steps[2].updated == ROWS && steps[2].shown,
+              "Scrolling by one should recycle one slot and move the rows, "
+              "%llu recycled, %d updated",
+              (unsigned long long)steps[2].recycles, steps[2].updated);
+  test_assert(steps[3].offset == ITEMS - ROWS &&
+                  steps[3].recycles == ROWS + 1,
+              "Scrolling past the end should clamp and recycle every slot, "
+              "%llu recycled",
+              (unsigned long long)steps[3].recycles);
+  test_assert(steps[3].mounted == ROWS && steps[3].unmounted == 0 &&
+                  steps[3].shown,
+              "Recycled slots should not remount, %d mounts", steps[3].mounted);
+  test_assert(steps[4].unmounted == ROWS - 5 && steps[4].offset == 0 &&
+                  steps[4].shown,
+              "Shrinking the list should unmount the empty rows, %d "
+              "unmounted",
+              steps[4].unmounted);
+  test_assert(steps[5].unmounted == ROWS && steps[5].mounted == ROWS,
+              "Shut should unmount the rest, %d unmounted", steps[5].unmounted);
+  test_assert(empty_context == EER_CONTEXT_SAME && !empty.ready,
+              "A list without rows should stage nothing");
+  test_assert(item_calls <= 6 * ROWS,
+              "Props should be requested for visible items only, %d calls",
+              item_calls);
+
+  return OK;
+}